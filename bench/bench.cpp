@@ -0,0 +1,74 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <iostream>
+#include <string_view>
+
+#include "bench.h"
+
+using namespace aoc24;
+
+namespace {
+
+struct Benchmark {
+    std::string_view name;
+    std::string_view description;
+    int (*run)(const bench::Arguments&);
+};
+
+constexpr Benchmark kBenchmarks[]{
+    {"columnar", "Row-wise versus columnar safe report counting, with an equivalence check",
+     bench::run_columnar_bench},
+    {"counters", "Hardware event counts for each phase of reading, parsing and solving",
+     bench::run_counters_bench},
+    {"equivalence",
+     "Check the optimized engines against references on edge cases and random inputs",
+     bench::run_equivalence_bench},
+    {"generate", "Write synthetic day 1 and day 2 inputs to a directory", bench::run_generate},
+    {"memory", "Peak memory per phase, checked against a budget per input byte",
+     bench::run_memory_bench},
+    {"pipeline", "Read, parse and solve both days, to compare builds", bench::run_pipeline_bench},
+    {"sketch", "Accuracy and speed of the similarity sketch versus the exact score",
+     bench::run_sketch_bench},
+    {"startup", "Time from spawn to first output and exit of aoc24_cpp on tiny inputs",
+     bench::run_startup_bench},
+    {"server", "Latency of query server answers from the in-memory indexes",
+     bench::run_server_bench},
+};
+
+void print_usage() {
+    std::cout << "Usage: aoc24_bench <benchmark> [arguments...]\n\nBenchmarks:\n";
+    for (const auto& benchmark : kBenchmarks)
+        std::cout << "  " << benchmark.name << "\t" << benchmark.description << '\n';
+}
+
+}  // namespace
+
+int main(const int argc, const char* const argv[]) {
+    if (argc < 2) {
+        print_usage();
+        return 1;
+    }
+
+    const std::string_view name{argv[1]};
+    const bench::Arguments arguments(argv + 2, argv + argc);
+
+    for (const auto& benchmark : kBenchmarks)
+        if (benchmark.name == name) return benchmark.run(arguments);
+
+    print_usage();
+    return 1;
+}
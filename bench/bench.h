@@ -0,0 +1,132 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_BENCH_BENCH_H_
+#define AOC24_CPP_BENCH_BENCH_H_
+
+#include <chrono>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace aoc24::bench {
+
+/**
+ * @brief The arguments following the benchmark name on the command line.
+ */
+using Arguments = std::vector<std::string_view>;
+
+/**
+ * @brief Measures the wall-clock time of a function call.
+ *
+ * @tparam F The type of the function.
+ * @param f The function to call.
+ * @return The elapsed time in milliseconds.
+ */
+template <typename F>
+double time_ms(F&& f) {
+    const auto start{std::chrono::steady_clock::now()};
+    std::forward<F>(f)();
+    const std::chrono::duration<double, std::milli> elapsed{std::chrono::steady_clock::now() -
+                                                            start};
+    return elapsed.count();
+}
+
+/**
+ * @brief Compares the approximate similarity sketch against the exact similarity score.
+ *
+ * @param arguments Unused.
+ * @return The process exit code.
+ */
+int run_sketch_bench(const Arguments& arguments);
+
+/**
+ * @brief Compares counting safe reports row by row with the columnar report table,
+ *        and checks that both agree on every report.
+ *
+ * @param arguments Unused.
+ * @return The process exit code, which is non-zero if the two disagree.
+ */
+int run_columnar_bench(const Arguments& arguments);
+
+/**
+ * @brief Counts cycles, instructions, branch and cache misses for each phase of both days,
+ *        where the kernel permits @c perf_event_open.
+ *
+ * @param arguments The directory with @c day1.txt and @c day2.txt,
+ *                  or nothing to generate synthetic inputs.
+ * @return The process exit code.
+ */
+int run_counters_bench(const Arguments& arguments);
+
+/**
+ * @brief Runs the differential checks of the fuzz harness deterministically:
+ *        hand-written edge cases first, then pseudo-random inputs.
+ *
+ * The first mismatch is minimized and printed.
+ *
+ * @param arguments The number of generated inputs and the random seed, both optional.
+ * @return The process exit code, which is non-zero if any engine disagreed with the reference.
+ */
+int run_equivalence_bench(const Arguments& arguments);
+
+/**
+ * @brief Measures the peak memory of each phase of both days
+ *        and checks it against a budget per byte of input.
+ *
+ * @param arguments Optionally @c --day and 1 or 2 to check only that day,
+ *                  then the directory with @c day1.txt and @c day2.txt from @c run_generate.
+ * @return The process exit code, which is non-zero if a day is over its budget.
+ */
+int run_memory_bench(const Arguments& arguments);
+
+/**
+ * @brief Measures the latency of query server answers on a synthetic dataset.
+ *
+ * @param arguments Unused.
+ * @return The process exit code.
+ */
+int run_server_bench(const Arguments& arguments);
+
+/**
+ * @brief Times aoc24_cpp from spawn to its first output and to its exit on the puzzle examples,
+ *        next to a trivial process as the baseline.
+ *
+ * @param arguments The path of aoc24_cpp, or nothing to use the one next to this executable.
+ * @return The process exit code, which is non-zero if a run failed.
+ */
+int run_startup_bench(const Arguments& arguments);
+
+/**
+ * @brief Writes synthetic day 1 and day 2 inputs, for instance to train a PGO build.
+ *
+ * @param arguments The directory to write @c day1.txt and @c day2.txt to.
+ * @return The process exit code.
+ */
+int run_generate(const Arguments& arguments);
+
+/**
+ * @brief Times reading, parsing and solving both days, to compare builds.
+ *
+ * @param arguments Optionally, a directory with inputs written by @c run_generate.
+ *                  Synthetic inputs are generated in a temporary directory otherwise.
+ * @return The process exit code.
+ */
+int run_pipeline_bench(const Arguments& arguments);
+
+}  // namespace aoc24::bench
+
+#endif  // AOC24_CPP_BENCH_BENCH_H_
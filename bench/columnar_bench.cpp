@@ -0,0 +1,98 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <spdlog/fmt/fmt.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "bench.h"
+#include "day2/Report.h"
+#include "day2/ReportTable.h"
+#include "day2/day2.h"
+#include "synthetic.h"
+
+namespace aoc24::bench {
+
+namespace {
+
+constexpr std::size_t kReportCount{1'000'000};
+constexpr int kQueryRepetitions{100};
+
+/**
+ * @brief Counts the reports whose table entries differ from the row-wise evaluation.
+ */
+[[nodiscard]] std::size_t count_mismatches(const std::vector<day2::Report>& reports,
+                                           const day2::ReportTable& table) {
+    std::size_t mismatches{0};
+    for (std::size_t i{0}; i < reports.size(); ++i) {
+        const auto problem_index{day2::report_is_safe_until(reports[i])};
+        const auto removal{day2::evaluate_problem_dampener(reports[i], problem_index)};
+        if (table.summary(i).first_violation == problem_index && table.removal(i) == removal)
+            continue;
+        if (mismatches++ < 10)
+            fmt::print("Mismatch for {}: first violation {} vs {}, removal {} vs {}\n", reports[i],
+                       table.summary(i).first_violation, problem_index,
+                       day2::dampener_removal_name(table.removal(i)),
+                       day2::dampener_removal_name(removal));
+    }
+    return mismatches;
+}
+
+}  // namespace
+
+int run_columnar_bench(const Arguments&) {
+    std::vector<day2::Report> reports{
+        {}, {5}, {5, 5}, {1, 200, 201, 202}, {1, 2, 200, 3, 4}, {300, 1, 2, 3}, {9, 1, 2, 3},
+        {1, 5, 2, 3}, {3, 2, 3, 4}, {1, 2, 3, 3, 3}, {-300, -299, -298, 100},
+    };
+    for (auto& levels : generate_report_levels(kReportCount, 3)) reports.emplace_back(levels);
+
+    fmt::print("{:>28} {:>10}\n", "stage", "ms");
+    std::ptrdiff_t row_safe{};
+    std::ptrdiff_t row_dampened_safe{};
+    const auto row_ms{time_ms([&] {
+        for (int i{0}; i < kQueryRepetitions; ++i) {
+            row_safe = day2::count_safe_reports(reports);
+            row_dampened_safe = day2::count_safe_reports_with_problem_dampener(reports);
+        }
+    })};
+    fmt::print("{:>28} {:>10.1f}\n", "rows: count both, x100", row_ms);
+
+    day2::ReportTable table{};
+    const auto ingest_ms{time_ms([&] { table = day2::ReportTable{reports}; })};
+    fmt::print("{:>28} {:>10.1f}\n", "table: ingest", ingest_ms);
+
+    std::size_t table_safe{};
+    std::size_t table_dampened_safe{};
+    const auto table_ms{time_ms([&] {
+        for (int i{0}; i < kQueryRepetitions; ++i) {
+            table_safe = table.count_safe();
+            table_dampened_safe = table.count_safe_with_problem_dampener();
+        }
+    })};
+    fmt::print("{:>28} {:>10.1f}\n", "table: count both, x100", table_ms);
+    fmt::print("Table memory: {} bytes for {} reports.\n", table.memory_usage(), table.size());
+
+    const auto mismatches{count_mismatches(reports, table)};
+    const bool counts_match{static_cast<std::size_t>(row_safe) == table_safe &&
+                            static_cast<std::size_t>(row_dampened_safe) == table_dampened_safe};
+    fmt::print("Safe: {} / {}, with dampener: {} / {}, mismatching reports: {}\n", row_safe,
+               table_safe, row_dampened_safe, table_dampened_safe, mismatches);
+    return mismatches == 0 && counts_match ? 0 : 1;
+}
+
+}  // namespace aoc24::bench
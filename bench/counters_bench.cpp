@@ -0,0 +1,94 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifndef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <system_error>
+
+#include "bench.h"
+#include "day1/day1.h"
+#include "day2/ReportTable.h"
+#include "day2/day2.h"
+#include "perf/perf.h"
+#include "utils.h"
+
+namespace aoc24::bench {
+
+int run_counters_bench(const Arguments& arguments) {
+    const auto generated{arguments.empty()};
+    const auto directory{generated ? std::filesystem::temp_directory_path() / "aoc24-counters"
+                                   : std::filesystem::path{arguments.front()}};
+    if (generated && run_generate({directory.native()}) != 0) return 1;
+
+
+    perf::PhaseRecorder recorder{true};
+    std::int64_t checksum{0};
+
+    const auto day1_path{directory / "day1.txt"};
+    const auto day1_contents{
+        recorder.measure("day 1 read", [&] { return utils::read_file_contents(day1_path); })};
+    auto lists{recorder.measure("day 1 parse", [&] {
+        return day1::try_parse_location_lists(day1_contents, day1_path).value_or_throw();
+    })};
+    recorder.measure("day 1 sort", [&] {
+        std::sort(lists.first.begin(), lists.first.end());
+        std::sort(lists.second.begin(), lists.second.end());
+    });
+    checksum += recorder.measure("day 1 evaluate distance", [&] {
+        return day1::sum_of_distances(lists.first, lists.second);
+    });
+    checksum += recorder.measure("day 1 evaluate similarity", [&] {
+        return day1::calculate_similarity_score_sorted(lists.first, lists.second);
+    });
+
+    const auto day2_contents{recorder.measure(
+        "day 2 read", [&] { return utils::read_file_contents(directory / "day2.txt"); })};
+    const auto reports{recorder.measure("day 2 parse", [&] {
+        return day2::try_parse_reactor_data(day2_contents).value_or_throw();
+    })};
+    checksum += recorder.measure("day 2 evaluate safe",
+                                 [&] { return day2::count_safe_reports(reports); });
+    checksum += recorder.measure("day 2 evaluate dampener", [&] {
+        return day2::count_safe_reports_with_problem_dampener(reports);
+    });
+    const auto table{
+        recorder.measure("day 2 index columnar", [&] { return day2::ReportTable{reports}; })};
+    checksum += recorder.measure("day 2 evaluate columnar", [&] {
+        return static_cast<std::int64_t>(table.count_safe() +
+                                         table.count_safe_with_problem_dampener());
+    });
+
+    fmt::print("{}Checksum: {}\n", recorder.format_table(), checksum);
+
+    if (generated) {
+        std::error_code error{};
+        std::filesystem::remove_all(directory, error);
+    }
+    return 0;
+}
+
+}  // namespace aoc24::bench
@@ -0,0 +1,135 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifndef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include <charconv>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "bench.h"
+#include "day2/Report.h"
+#include "differential.h"
+
+namespace aoc24::bench {
+
+namespace {
+
+constexpr std::size_t kDefaultIterations{100'000};
+constexpr std::size_t kMaxInputSize{512};
+
+/**
+ * @brief Reports that sit on the boundaries of the safety rules and of @c int.
+ */
+[[nodiscard]] std::vector<day2::Report> edge_case_reports() {
+    return {
+        {},
+        {7},
+        {INT_MIN},
+        {INT_MAX},
+        {5, 5},
+        {INT_MIN, INT_MAX},
+        {INT_MAX, INT_MIN},
+        {INT_MAX, INT_MIN, INT_MIN + 1},
+        {INT_MIN, INT_MAX, INT_MAX - 1},
+        {INT_MAX - 3, INT_MAX - 2, INT_MAX},
+        {INT_MIN + 3, INT_MIN + 1, INT_MIN},
+        {INT_MIN, INT_MIN + 1, INT_MAX, INT_MIN + 2},
+        {9, 1, 2, 3},
+        {1, 9, 2, 3},
+        {3, 2, 3, 4},
+        {1, 2, 3, 3, 3},
+        {1, 2, 200, 3, 4},
+        {1, 5, 6, 7},
+        {7, 6, 2, 1},
+    };
+}
+
+[[nodiscard]] std::size_t parse_argument(const Arguments& arguments, const std::size_t index,
+                                         const std::size_t fallback) {
+    if (arguments.size() <= index) return fallback;
+    std::size_t value{fallback};
+    const auto argument{arguments[index]};
+    std::from_chars(argument.data(), argument.data() + argument.size(), value);
+    return value;
+}
+
+}  // namespace
+
+int run_equivalence_bench(const Arguments& arguments) {
+    const auto iterations{parse_argument(arguments, 0, kDefaultIterations)};
+    const auto seed{parse_argument(arguments, 1, 1)};
+    spdlog::set_level(spdlog::level::off);
+
+    std::vector<fuzz::Mismatch> mismatches{};
+    const auto reports{edge_case_reports()};
+    mismatches.push_back(fuzz::check_reports(reports));
+    for (const auto& report : reports) mismatches.push_back(fuzz::check_reports({report}));
+
+    constexpr int kMax{INT_MAX};
+    mismatches.push_back(fuzz::check_location_lists({}, {}, {}));
+    mismatches.push_back(fuzz::check_location_lists({0}, {kMax}, {1}));
+    mismatches.push_back(fuzz::check_location_lists({kMax, kMax, 0}, {kMax, 0, kMax}, {0, 2}));
+    mismatches.push_back(
+        fuzz::check_location_lists({3, 4, 2, 1, 3, 3}, {4, 3, 5, 3, 9, 3}, {1, 1, 4}));
+
+    for (const auto text :
+         {"", "\n", "1", "1 2\n\n3", "1  2 \n", "2147483647 0\n", "2147483648\n", "-1 2\n",
+          "1\t2\n3 4", "\n\n\n", "12 x\n4 5\n"}) {
+        mismatches.push_back(fuzz::check_reactor_data_text(text));
+        mismatches.push_back(fuzz::check_location_lists_text(text));
+    }
+
+    for (const auto& mismatch : mismatches) {
+        if (!mismatch) continue;
+        fmt::print("Edge case mismatch: {}\n", *mismatch);
+        return 1;
+    }
+
+    std::mt19937_64 random{seed};
+    std::uniform_int_distribution<std::size_t> sizes{0, kMaxInputSize};
+    std::uniform_int_distribution<unsigned> bytes{0, 255};
+    for (std::size_t i{0}; i < iterations; ++i) {
+        std::vector<std::uint8_t> input(sizes(random));
+        for (auto& value : input) value = static_cast<std::uint8_t>(bytes(random));
+        if (!fuzz::check_input(input.data(), input.size())) continue;
+
+        const auto minimized{fuzz::minimize_input(input)};
+        fmt::print("Mismatch on generated input {} (seed {}): {}\nMinimized input: {:02x}\n", i,
+                   seed, *fuzz::check_input(minimized.data(), minimized.size()),
+                   fmt::join(minimized, " "));
+        return 1;
+    }
+
+    fmt::print("No mismatches in {} edge cases and {} generated inputs (seed {}).\n",
+               mismatches.size(), iterations, seed);
+    return 0;
+}
+
+}  // namespace aoc24::bench
@@ -0,0 +1,184 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifndef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+#include "bench.h"
+#include "day1/day1.h"
+#include "day2/ReportTable.h"
+#include "day2/day2.h"
+#include "memory/footprint.h"
+#include "perf/perf.h"
+#include "utils.h"
+
+namespace aoc24::bench {
+
+namespace {
+
+// Each budget is the most memory a day may use at once per byte of its input file,
+// about a quarter above what the current data layout needs on the generated inputs:
+// day 1 keeps the file and both ID vectors (1.75), and day 2 the file, one vector per report
+// and the columnar table (7.0).
+constexpr double kDay1Budget{2.25};
+constexpr double kDay2Budget{8.75};
+
+/**
+ * @brief Tracks the memory a day of phases used on top of what was in use before it.
+ */
+class DayFootprint final {
+    const perf::PhaseRecorder& recorder_;
+    std::size_t first_phase_{};
+    std::uint64_t heap_baseline_{};
+    std::uint64_t rss_baseline_{};
+
+  public:
+    explicit DayFootprint(const perf::PhaseRecorder& recorder)
+        : recorder_{recorder},
+          first_phase_{recorder.phases().size()},
+          heap_baseline_{memory::heap_bytes().value_or(0)},
+          rss_baseline_{memory::rss_bytes()} {}
+
+    /**
+     * @brief Returns the peak memory use of the phases since construction, in bytes.
+     *
+     * Tracked heap bytes are exact. Without tracking, the growth of the resident set size
+     * is a lower bound, since memory freed earlier in the run may be reused.
+     */
+    [[nodiscard]] std::uint64_t peak_bytes() const {
+        std::uint64_t peak{0};
+        const auto& phases{recorder_.phases()};
+        for (auto i{first_phase_}; i < phases.size(); ++i) {
+            const auto& phase{phases[i]};
+            peak = std::max(peak, phase.peak_heap_bytes
+                                      ? *phase.peak_heap_bytes - heap_baseline_
+                                      : std::max(phase.peak_rss_bytes, rss_baseline_) -
+                                            rss_baseline_);
+        }
+        return peak;
+    }
+};
+
+/**
+ * @brief Prints how a day's peak memory compares with its budget.
+ *
+ * @return True if the day stayed within its budget.
+ */
+bool check_budget(const char* day, const std::uint64_t peak_bytes,
+                  const std::uintmax_t input_bytes, const double budget) {
+    const auto bytes_per_input_byte{static_cast<double>(peak_bytes) /
+                                    static_cast<double>(std::max<std::uintmax_t>(1, input_bytes))};
+    const bool within_budget{bytes_per_input_byte <= budget};
+    fmt::print("{}: {} bytes at peak for {} input bytes, {:.2f} per input byte (budget {:.2f}): "
+               "{}\n",
+               day, peak_bytes, input_bytes, bytes_per_input_byte, budget,
+               within_budget ? "ok" : "OVER BUDGET");
+    return within_budget;
+}
+
+}  // namespace
+
+int run_memory_bench(const Arguments& arguments) {
+    // `--day N` checks a single budget, so that each day can be a test of its own.
+    auto remaining{arguments};
+    int only_day{0};
+    if (remaining.size() >= 2 && remaining.front() == "--day") {
+        only_day = remaining[1] == "1" ? 1 : remaining[1] == "2" ? 2 : -1;
+        remaining.erase(remaining.begin(), remaining.begin() + 2);
+    }
+    if (only_day < 0 || remaining.size() != 1) {
+        fmt::print("Usage: aoc24_bench memory [--day 1|2] <directory>\n"
+                   "Write the inputs with aoc24_bench generate first: generating them here would "
+                   "leave freed memory resident, which the days would reuse unnoticed.\n");
+        return 1;
+    }
+    const std::filesystem::path directory{remaining.front()};
+
+    perf::PhaseRecorder recorder{true};
+    std::int64_t checksum{0};
+    std::optional<std::uint64_t> day1_peak{};
+    std::optional<std::uint64_t> day2_peak{};
+
+    const auto day1_path{directory / "day1.txt"};
+    if (only_day != 2) {
+        const DayFootprint day1{recorder};
+        {
+            const auto contents{recorder.measure(
+                "day 1 read", [&] { return utils::read_file_contents(day1_path); })};
+            auto lists{recorder.measure("day 1 parse", [&] {
+                return day1::try_parse_location_lists(contents, day1_path).value_or_throw();
+            })};
+            recorder.measure("day 1 sort", [&] {
+                std::sort(lists.first.begin(), lists.first.end());
+                std::sort(lists.second.begin(), lists.second.end());
+            });
+            checksum += recorder.measure("day 1 evaluate", [&] {
+                return day1::sum_of_distances(lists.first, lists.second) +
+                       day1::calculate_similarity_score_sorted(lists.first, lists.second);
+            });
+        }
+        day1_peak = day1.peak_bytes();
+    }
+
+    const auto day2_path{directory / "day2.txt"};
+    if (only_day != 1) {
+        const DayFootprint day2{recorder};
+        {
+            const auto contents{recorder.measure(
+                "day 2 read", [&] { return utils::read_file_contents(day2_path); })};
+            const auto reports{recorder.measure("day 2 parse", [&] {
+                return day2::try_parse_reactor_data(contents).value_or_throw();
+            })};
+            checksum += recorder.measure("day 2 evaluate", [&] {
+                return day2::count_safe_reports_with_problem_dampener(reports);
+            });
+            const auto table{recorder.measure("day 2 index columnar",
+                                              [&] { return day2::ReportTable{reports}; })};
+            checksum += static_cast<std::int64_t>(table.count_safe_with_problem_dampener());
+        }
+        day2_peak = day2.peak_bytes();
+    }
+
+    fmt::print("{}Checksum: {}\n", recorder.format_table(), checksum);
+    if (!memory::allocations_tracked())
+        fmt::print("Allocations are not tracked in this build, so the budgets are checked "
+                   "against the growth of the resident set size, which can miss regressions. "
+                   "Configure with -DAOC24_TRACK_ALLOCATIONS=ON for exact numbers.\n");
+
+    bool within_budgets{true};
+    if (day1_peak)
+        within_budgets &= check_budget("Day 1", *day1_peak, std::filesystem::file_size(day1_path),
+                                       kDay1Budget);
+    if (day2_peak)
+        within_budgets &= check_budget("Day 2", *day2_peak, std::filesystem::file_size(day2_path),
+                                       kDay2Budget);
+
+    return within_budgets ? 0 : 1;
+}
+
+}  // namespace aoc24::bench
@@ -0,0 +1,128 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifndef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <numeric>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "bench.h"
+#include "day1/day1.h"
+#include "day2/day2.h"
+#include "synthetic.h"
+
+namespace aoc24::bench {
+
+namespace {
+
+constexpr std::size_t kPairCount{1'000'000};
+constexpr std::size_t kReportCount{1'000'000};
+constexpr int kRepetitions{7};
+// Keeps every generated level non-negative, so that the day 2 parser accepts the file.
+constexpr int kMinFileStartLevel{30};
+
+/**
+ * @brief Runs a function repeatedly and prints its fastest and median time.
+ */
+template <typename F>
+void report_timing(const char* name, F&& f) {
+    std::vector<double> times{};
+    for (int i{0}; i < kRepetitions; ++i) times.push_back(time_ms(f));
+    std::sort(times.begin(), times.end());
+    fmt::print("{:>24} {:>10.1f} {:>10.1f}\n", name, times.front(), times[times.size() / 2]);
+}
+
+}  // namespace
+
+int run_generate(const Arguments& arguments) {
+    if (arguments.empty()) {
+        fmt::print("Usage: aoc24_bench generate <directory>\n");
+        return 1;
+    }
+
+    const std::filesystem::path directory{arguments.front()};
+    std::filesystem::create_directories(directory);
+
+    auto lists{generate_location_lists(kPairCount, 90'000, 0.8, 1)};
+    for (auto* list : {&lists.first, &lists.second})
+        for (auto& id : *list) id += 10'000;
+    write_location_lists(directory / "day1.txt", lists);
+    write_reactor_data(directory / "day2.txt",
+                       generate_report_levels(kReportCount, 1, kMinFileStartLevel));
+
+    fmt::print("Wrote {} and {}.\n", (directory / "day1.txt").string(),
+               (directory / "day2.txt").string());
+    return 0;
+}
+
+int run_pipeline_bench(const Arguments& arguments) {
+    const auto generated{arguments.empty()};
+    const auto directory{generated ? std::filesystem::temp_directory_path() / "aoc24-pipeline"
+                                   : std::filesystem::path{arguments.front()}};
+    if (generated && run_generate({directory.native()}) != 0) return 1;
+
+    // The synthetic similarity score does not fit the int returned by the in-memory solution,
+    // which would otherwise log an error on every repetition.
+    spdlog::set_level(spdlog::level::off);
+
+    fmt::print("{:>24} {:>10} {:>10}\n", "stage", "min ms", "median ms");
+    std::int64_t checksum{0};
+
+    report_timing("day 1 read and parse", [&] {
+        const auto lists{day1::read_location_lists(directory / "day1.txt")};
+        checksum += static_cast<std::int64_t>(lists.first.size());
+    });
+    report_timing("day 1 read and solve", [&] {
+        auto [left_list, right_list]{day1::read_location_lists(directory / "day1.txt")};
+        checksum += day1::calculate_similarity_score(left_list, std::vector{right_list});
+        const auto distances{
+            day1::calculate_distances(std::move(left_list), std::move(right_list))};
+        checksum += std::accumulate(distances.begin(), distances.end(), std::int64_t{0});
+    });
+    report_timing("day 2 read and parse", [&] {
+        checksum += static_cast<std::int64_t>(
+            day2::read_reactor_data(directory / "day2.txt").size());
+    });
+    report_timing("day 2 read and solve", [&] {
+        const auto reports{day2::read_reactor_data(directory / "day2.txt")};
+        checksum += day2::count_safe_reports(reports);
+        checksum += day2::count_safe_reports_with_problem_dampener(reports);
+    });
+
+    fmt::print("Checksum: {}\n", checksum);
+
+    if (generated) {
+        std::error_code error{};
+        std::filesystem::remove_all(directory, error);
+    }
+    return 0;
+}
+
+}  // namespace aoc24::bench
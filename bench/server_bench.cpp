@@ -0,0 +1,83 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <spdlog/fmt/fmt.h>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "day2/Report.h"
+#include "server/Dataset.h"
+#include "server/server.h"
+#include "synthetic.h"
+
+namespace aoc24::bench {
+
+int run_server_bench(const Arguments&) {
+    constexpr std::size_t kPairCount{1'000'000};
+    constexpr std::size_t kReportCount{1'000'000};
+    constexpr std::size_t kQueryCount{1'000'000};
+
+    server::Dataset dataset{};
+    const auto index_ms{time_ms([&] {
+        auto [left_list, right_list]{generate_location_lists(kPairCount, 100'000, 0.8, 7)};
+        dataset.day1 = server::index_location_lists(std::move(left_list), std::move(right_list));
+
+        std::vector<day2::Report> reports{};
+        for (auto& levels : generate_report_levels(kReportCount, 7))
+            reports.emplace_back(std::move(levels));
+        dataset.day2 = server::index_reports(reports);
+    })};
+    fmt::print("Indexed {} pairs and {} reports in {:.1f} ms.\n", kPairCount, kReportCount,
+               index_ms);
+
+    std::mt19937_64 engine{11};
+    std::uniform_int_distribution<int> id{0, 99'999};
+    std::uniform_int_distribution<std::size_t> report{0, kReportCount - 1};
+    std::vector<std::string> similarity_queries{};
+    std::vector<std::string> report_queries{};
+    for (std::size_t i{0}; i < 1024; ++i) {
+        similarity_queries.push_back(fmt::format("similarity {}", id(engine)));
+        report_queries.push_back(fmt::format("report {}", report(engine)));
+    }
+
+    const std::pair<const char*, std::vector<std::string>> workloads[]{
+        {"distance", {"distance"}},
+        {"safe", {"safe 0", "safe 1"}},
+        {"similarity ID", similarity_queries},
+        {"report INDEX", report_queries},
+    };
+
+    fmt::print("{:>14} {:>12}\n", "query", "ns/query");
+    for (const auto& [name, queries] : workloads) {
+        std::size_t answer_bytes{0};
+        const auto elapsed_ms{time_ms([&] {
+            for (std::size_t i{0}; i < kQueryCount; ++i)
+                answer_bytes += server::answer_query(dataset, queries[i % queries.size()]).size();
+        })};
+        fmt::print("{:>14} {:>12.0f}\n", name,
+                   elapsed_ms * 1e6 / static_cast<double>(kQueryCount));
+        if (answer_bytes == 0) return 1;
+    }
+
+    return 0;
+}
+
+}  // namespace aoc24::bench
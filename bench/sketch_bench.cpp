@@ -0,0 +1,92 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "bench.h"
+#include "day1/SimilaritySketch.h"
+#include "synthetic.h"
+
+namespace aoc24::bench {
+
+namespace {
+
+/**
+ * @brief The exact similarity score, computed like @c calculate_similarity_score
+ *        but without narrowing the result to @c int.
+ */
+[[nodiscard]] std::int64_t exact_similarity_score(const std::vector<int>& left_list,
+                                                  std::vector<int> right_list) {
+    std::sort(right_list.begin(), right_list.end());
+    std::int64_t similarity_score{0};
+    for (const int left_val : left_list) {
+        const auto [l, r]{std::equal_range(right_list.begin(), right_list.end(), left_val)};
+        similarity_score += left_val * std::distance(l, r);
+    }
+    return similarity_score;
+}
+
+}  // namespace
+
+int run_sketch_bench(const Arguments&) {
+    constexpr std::uint32_t kIdRange{1'000'000};
+    constexpr std::size_t kPairCounts[]{100'000, 1'000'000, 4'000'000};
+    constexpr double kSkews[]{0.0, 0.8, 1.2};
+
+    fmt::print("{:>9} {:>5} {:>10} {:>10} {:>12} {:>10} {:>10}\n", "pairs", "skew", "exact ms",
+               "sketch ms", "memory", "rel error", "rel bound");
+
+    for (const auto pair_count : kPairCounts) {
+        for (const auto skew : kSkews) {
+            const auto [left_list, right_list]{
+                generate_location_lists(pair_count, kIdRange, skew, 42)};
+
+            std::int64_t exact{};
+            const auto exact_ms{
+                time_ms([&] { exact = exact_similarity_score(left_list, right_list); })};
+
+            day1::SimilaritySketch sketch{day1::SketchConfig{}};
+            double estimate{};
+            const auto sketch_ms{time_ms([&] {
+                for (std::size_t i{0}; i < pair_count; ++i) {
+                    sketch.add_left(left_list[i]);
+                    sketch.add_right(right_list[i]);
+                }
+                estimate = sketch.estimate();
+            })};
+
+            const auto exact_value{static_cast<double>(exact)};
+            const auto relative_error{exact == 0 ? 0.0
+                                                 : std::abs(estimate - exact_value) / exact_value};
+            const auto relative_bound{exact == 0 ? 0.0 : sketch.error_bound() / exact_value};
+
+            fmt::print("{:>9} {:>5.1f} {:>10.1f} {:>10.1f} {:>12} {:>10.2e} {:>10.2e}\n",
+                       pair_count, skew, exact_ms, sketch_ms, sketch.memory_usage(),
+                       relative_error, relative_bound);
+        }
+    }
+
+    return 0;
+}
+
+}  // namespace aoc24::bench
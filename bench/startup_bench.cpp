@@ -0,0 +1,188 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifndef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "bench.h"
+
+extern char** environ;
+
+namespace aoc24::bench {
+
+namespace {
+
+constexpr int kWarmupRuns{20};
+constexpr int kRuns{200};
+
+// The examples from the puzzle descriptions: the smallest inputs that exercise a whole run.
+constexpr auto kDay1Example{"3   4\n4   3\n2   5\n1   3\n3   9\n3   3\n"};
+constexpr auto kDay2Example{
+    "7 6 4 2 1\n1 2 7 8 9\n9 7 6 2 1\n1 3 2 4 5\n8 6 4 4 1\n1 3 6 7 9\n"};
+
+/**
+ * @brief The time from spawning a process until it first wrote to stdout and until it exited.
+ */
+struct StartupTiming {
+    double first_output_ms{};
+    double exit_ms{};
+};
+
+/**
+ * @brief Spawns a process with stdout on a pipe and stderr discarded, and times it.
+ *
+ * @return The timing, or nothing if the process could not be spawned or did not exit cleanly.
+ */
+std::optional<StartupTiming> time_process(const std::vector<std::string>& command) {
+    std::vector<char*> argv{};
+    for (const auto& argument : command) argv.push_back(const_cast<char*>(argument.c_str()));
+    argv.push_back(nullptr);
+
+    int pipe_fds[2];
+    if (pipe2(pipe_fds, O_CLOEXEC) != 0) return std::nullopt;
+
+    posix_spawn_file_actions_t actions{};
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, pipe_fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    using Clock = std::chrono::steady_clock;
+    const auto start{Clock::now()};
+    pid_t pid{};
+    const auto spawn_error{
+        posix_spawn(&pid, argv.front(), &actions, nullptr, argv.data(), environ)};
+    posix_spawn_file_actions_destroy(&actions);
+    close(pipe_fds[1]);
+    if (spawn_error != 0) {
+        close(pipe_fds[0]);
+        SPDLOG_ERROR("Failed to spawn {}: {}", command.front(), std::strerror(spawn_error));
+        return std::nullopt;
+    }
+
+    std::optional<Clock::time_point> first_output{};
+    char buffer[4096];
+    for (;;) {
+        const auto count{read(pipe_fds[0], buffer, sizeof(buffer))};
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) break;
+        if (!first_output) first_output = Clock::now();
+    }
+    close(pipe_fds[0]);
+
+    int status{};
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+    const auto end{Clock::now()};
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || !first_output) return std::nullopt;
+
+    const std::chrono::duration<double, std::milli> to_output{*first_output - start};
+    const std::chrono::duration<double, std::milli> to_exit{end - start};
+    return StartupTiming{to_output.count(), to_exit.count()};
+}
+
+/**
+ * @brief Times a command repeatedly and prints the fastest and median times.
+ *
+ * @return The median time to exit in milliseconds, or nothing if any run failed.
+ */
+std::optional<double> report_startup(const char* name, const std::vector<std::string>& command) {
+    for (int i{0}; i < kWarmupRuns; ++i)
+        if (!time_process(command)) return std::nullopt;
+
+    std::vector<double> to_output{};
+    std::vector<double> to_exit{};
+    for (int i{0}; i < kRuns; ++i) {
+        const auto timing{time_process(command)};
+        if (!timing) return std::nullopt;
+        to_output.push_back(timing->first_output_ms);
+        to_exit.push_back(timing->exit_ms);
+    }
+
+    std::sort(to_output.begin(), to_output.end());
+    std::sort(to_exit.begin(), to_exit.end());
+    const auto median_exit{to_exit[to_exit.size() / 2]};
+    fmt::print("{:>16} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f}\n", name, to_output.front(),
+               to_output[to_output.size() / 2], to_exit.front(), median_exit);
+    return median_exit;
+}
+
+}  // namespace
+
+int run_startup_bench(const Arguments& arguments) {
+    std::error_code error{};
+    const auto executable{
+        arguments.empty()
+            ? std::filesystem::read_symlink("/proc/self/exe", error).parent_path() / "aoc24_cpp"
+            : std::filesystem::path{arguments.front()}};
+    if (error || !std::filesystem::exists(executable)) {
+        fmt::print("Usage: aoc24_bench startup [path to aoc24_cpp]\n");
+        return 1;
+    }
+
+    const auto directory{std::filesystem::temp_directory_path() / "aoc24-startup"};
+    std::filesystem::create_directories(directory);
+    std::ofstream{directory / "day1.txt"} << kDay1Example;
+    std::ofstream{directory / "day2.txt"} << kDay2Example;
+
+    fmt::print("{}, {} runs each\n", executable.string(), kRuns);
+    fmt::print("{:>16} {:>10} {:>10} {:>10} {:>10}\n", "command", "output min", "output med",
+               "exit min", "exit med");
+
+    // What any process costs to spawn and reap on this machine.
+    const auto baseline{report_startup("/bin/echo", {"/bin/echo", "-n", "x"})};
+    std::optional<double> slowest{};
+    for (const auto day : {"1", "2"}) {
+        const auto input{(directory / (std::string{"day"} + day + ".txt")).string()};
+        const auto median{report_startup((std::string{"day "} + day).c_str(),
+                                         {executable.string(), "--day", day, "--input", input})};
+        if (!median) {
+            fmt::print("Failed to run day {}.\n", day);
+            slowest.reset();
+            break;
+        }
+        slowest = std::max(slowest.value_or(0.0), *median);
+    }
+
+    std::filesystem::remove_all(directory, error);
+    if (!baseline || !slowest) return 1;
+
+    fmt::print("Slowest median is {:.3f} ms above the baseline.\n", *slowest - *baseline);
+    return 0;
+}
+
+}  // namespace aoc24::bench
@@ -0,0 +1,185 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_BENCH_SYNTHETIC_H_
+#define AOC24_CPP_BENCH_SYNTHETIC_H_
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "AocException.h"
+
+namespace aoc24::bench {
+
+/**
+ * @brief Draws location IDs from a Zipf distribution.
+ *
+ * The most frequent ranks are scattered over the ID range,
+ * so frequent IDs are not simply the smallest ones.
+ */
+class ZipfIdGenerator final {
+    std::vector<double> cumulative_weights_{};
+    std::uint32_t id_range_{};
+    std::mt19937_64 engine_;
+
+  public:
+    /**
+     * @brief Constructs a generator.
+     *
+     * @param id_range The number of distinct IDs, which are drawn from @c [0, id_range).
+     * @param skew The Zipf exponent. Zero gives a uniform distribution.
+     * @param seed The seed of the random engine.
+     */
+    ZipfIdGenerator(const std::uint32_t id_range, const double skew, const std::uint64_t seed)
+        : id_range_{std::max<std::uint32_t>(1, id_range)}, engine_{seed} {
+        cumulative_weights_.reserve(id_range_);
+        double total{0.0};
+        for (std::uint32_t rank{0}; rank < id_range_; ++rank) {
+            total += 1.0 / std::pow(static_cast<double>(rank) + 1.0, skew);
+            cumulative_weights_.push_back(total);
+        }
+    }
+
+    /**
+     * @brief Draws the next ID.
+     *
+     * @return An ID in @c [0, id_range).
+     */
+    [[nodiscard]] int next() {
+        std::uniform_real_distribution<double> distribution{0.0, cumulative_weights_.back()};
+        const auto it{std::lower_bound(cumulative_weights_.begin(), cumulative_weights_.end(),
+                                       distribution(engine_))};
+        const auto rank{static_cast<std::uint64_t>(it - cumulative_weights_.begin())};
+        return static_cast<int>((rank * 2654435761ULL) % id_range_);
+    }
+};
+
+/**
+ * @brief Generates a pair of location lists.
+ *
+ * @param pair_count The number of IDs in each list.
+ * @param id_range The number of distinct IDs.
+ * @param skew The Zipf exponent of the ID distribution.
+ * @param seed The seed of the random engine.
+ * @return The left and right lists.
+ */
+inline std::pair<std::vector<int>, std::vector<int>> generate_location_lists(
+    const std::size_t pair_count, const std::uint32_t id_range, const double skew,
+    const std::uint64_t seed) {
+    ZipfIdGenerator left_generator{id_range, skew, seed};
+    ZipfIdGenerator right_generator{id_range, skew, seed + 1};
+    std::pair<std::vector<int>, std::vector<int>> lists{};
+    lists.first.reserve(pair_count);
+    lists.second.reserve(pair_count);
+    for (std::size_t i{0}; i < pair_count; ++i) {
+        lists.first.push_back(left_generator.next());
+        lists.second.push_back(right_generator.next());
+    }
+    return lists;
+}
+
+/**
+ * @brief Generates reactor reports, most of which are safe or safe with the problem dampener.
+ *
+ * Levels can go up to 25 below the first level of their report.
+ * Reports written to an input file therefore need a @p min_start of at least 25,
+ * because the parser only accepts non-negative levels.
+ *
+ * @param report_count The number of reports.
+ * @param seed The seed of the random engine.
+ * @param min_start The lowest first level of a report.
+ * @return The levels of each report.
+ */
+inline std::vector<std::vector<int>> generate_report_levels(const std::size_t report_count,
+                                                            const std::uint64_t seed,
+                                                            const int min_start = 1) {
+    std::mt19937_64 engine{seed};
+    std::uniform_int_distribution<int> length{5, 8};
+    std::uniform_int_distribution<int> start{min_start, 99};
+    std::uniform_int_distribution<int> step{1, 3};
+    std::uniform_int_distribution<int> defect{0, 9};
+
+    std::vector<std::vector<int>> reports(report_count);
+    for (auto& levels : reports) {
+        const auto level_count{static_cast<std::size_t>(length(engine))};
+        const int direction{defect(engine) < 5 ? 1 : -1};
+        levels.push_back(start(engine));
+        while (levels.size() < level_count)
+            levels.push_back(levels.back() + direction * step(engine));
+
+        // Three in ten reports get a bad level, which the dampener can remove only sometimes.
+        if (defect(engine) < 3) {
+            std::uniform_int_distribution<std::size_t> position{0, level_count - 1};
+            levels[position(engine)] += 4 * direction * (defect(engine) < 5 ? 1 : -1);
+        }
+    }
+    return reports;
+}
+
+/**
+ * @brief Writes a file, throwing if that fails.
+ */
+inline void write_text_file(const std::filesystem::path& file_path,
+                            const fmt::memory_buffer& contents) {
+    std::ofstream file{file_path, std::ios::binary};
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    if (!file) throw FileWriteException{file_path, errno};
+}
+
+/**
+ * @brief Writes location lists in the day 1 input format.
+ *
+ * @param file_path The file to write.
+ * @param lists The left and right lists, of equal length.
+ * @throws FileWriteException If the file cannot be written.
+ */
+inline void write_location_lists(const std::filesystem::path& file_path,
+                                 const std::pair<std::vector<int>, std::vector<int>>& lists) {
+    fmt::memory_buffer contents{};
+    for (std::size_t i{0}; i < lists.first.size(); ++i)
+        fmt::format_to(std::back_inserter(contents), "{}   {}\n", lists.first[i], lists.second[i]);
+    write_text_file(file_path, contents);
+}
+
+/**
+ * @brief Writes reports in the day 2 input format.
+ *
+ * @param file_path The file to write.
+ * @param reports The levels of each report.
+ * @throws FileWriteException If the file cannot be written.
+ */
+inline void write_reactor_data(const std::filesystem::path& file_path,
+                               const std::vector<std::vector<int>>& reports) {
+    fmt::memory_buffer contents{};
+    for (const auto& levels : reports)
+        fmt::format_to(std::back_inserter(contents), "{}\n", fmt::join(levels, " "));
+    write_text_file(file_path, contents);
+}
+
+}  // namespace aoc24::bench
+
+#endif  // AOC24_CPP_BENCH_SYNTHETIC_H_
@@ -0,0 +1,439 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "differential.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "day1/day1.h"
+#include "day2/ReportTable.h"
+#include "day2/day2.h"
+#include "watch/watch.h"
+
+namespace aoc24::fuzz {
+
+namespace {
+
+constexpr std::size_t kMaxReportCount{64};
+constexpr std::size_t kMaxLevelCount{10};
+constexpr std::size_t kMaxPairCount{256};
+constexpr std::string_view kTextAlphabet{"0123456789   \t\n\n-"};
+
+/**
+ * @brief Hands out the bytes of a fuzzer input, and zeros once they run out.
+ */
+class InputReader final {
+    const std::uint8_t* data_{};
+    std::size_t size_{};
+    std::size_t position_{0};
+
+  public:
+    InputReader(const std::uint8_t* data, const std::size_t size) : data_{data}, size_{size} {}
+
+    [[nodiscard]] bool empty() const { return position_ >= size_; }
+
+    [[nodiscard]] std::uint8_t byte() { return empty() ? 0 : data_[position_++]; }
+
+    [[nodiscard]] std::uint32_t word() {
+        std::uint32_t value{0};
+        for (int i{0}; i < 4; ++i) value = value << 8 | byte();
+        return value;
+    }
+};
+
+/**
+ * @brief Decodes a level, mostly as a small step from the previous one.
+ */
+[[nodiscard]] int next_level(InputReader& reader, const int previous) {
+    constexpr auto kMin{std::numeric_limits<int>::min()};
+    constexpr auto kMax{std::numeric_limits<int>::max()};
+    const auto selector{reader.byte()};
+    if (selector < 200)
+        return static_cast<int>(
+            std::clamp<std::int64_t>(std::int64_t{previous} + selector % 9 - 4, kMin, kMax));
+    if (selector < 220) return kMin + (selector - 200);
+    if (selector < 240) return kMax - (selector - 220);
+    return static_cast<int>(reader.word());
+}
+
+/**
+ * @brief Decodes a location ID, mostly from a small range so that IDs repeat.
+ */
+[[nodiscard]] int next_location_id(InputReader& reader) {
+    constexpr auto kMax{std::numeric_limits<int>::max()};
+    const auto selector{reader.byte()};
+    if (selector < 192) return selector % 24;
+    if (selector < 224) return kMax - (selector - 192);
+    return static_cast<int>(reader.word() & static_cast<std::uint32_t>(kMax));
+}
+
+[[nodiscard]] std::vector<day2::Report> decode_reports(InputReader& reader) {
+    std::vector<day2::Report> reports{};
+    while (!reader.empty() && reports.size() < kMaxReportCount) {
+        std::vector<day2::Report::Level> levels(reader.byte() % (kMaxLevelCount + 1));
+        int previous{0};
+        for (auto& level : levels) previous = level = next_level(reader, previous);
+        reports.emplace_back(std::move(levels));
+    }
+    return reports;
+}
+
+[[nodiscard]] std::string decode_text(InputReader& reader) {
+    std::string text{};
+    while (!reader.empty()) {
+        const auto value{reader.byte()};
+        text += value < 240 ? kTextAlphabet[value % kTextAlphabet.size()]
+                            : static_cast<char>(value);
+    }
+    return text;
+}
+
+/**
+ * @brief Checks whether levels are strictly monotonic with steps of one to three,
+ *        computing the steps in 64 bits.
+ */
+[[nodiscard]] bool reference_is_safe(const std::vector<int>& levels) {
+    if (levels.size() < 2) return true;
+    const bool increasing{levels[1] > levels[0]};
+    for (std::size_t i{1}; i < levels.size(); ++i) {
+        const auto step{std::int64_t{levels[i]} - levels[i - 1]};
+        const auto rise{increasing ? step : -step};
+        if (rise < 1 || rise > 3) return false;
+    }
+    return true;
+}
+
+[[nodiscard]] std::vector<int> without(std::vector<int> levels, const std::size_t index) {
+    levels.erase(levels.begin() + static_cast<std::ptrdiff_t>(index));
+    return levels;
+}
+
+/**
+ * @brief Checks whether levels are safe after removing at most one of them, by trying each.
+ */
+[[nodiscard]] bool reference_is_dampened_safe(const std::vector<int>& levels) {
+    if (reference_is_safe(levels)) return true;
+    for (std::size_t i{0}; i < levels.size(); ++i)
+        if (reference_is_safe(without(levels, i))) return true;
+    return false;
+}
+
+/**
+ * @brief Finds the first level that breaks the direction set by the first two levels.
+ */
+[[nodiscard]] std::size_t reference_first_violation(const std::vector<int>& levels) {
+    if (levels.size() < 2) return levels.size();
+    const auto direction{(levels[1] > levels[0]) - (levels[1] < levels[0])};
+    for (std::size_t i{1}; i < levels.size(); ++i) {
+        const auto rise{(std::int64_t{levels[i]} - levels[i - 1]) * direction};
+        if (rise < 1 || rise > 3) return i;
+    }
+    return levels.size();
+}
+
+/**
+ * @brief Checks that a removal reported by an engine is one that makes the report safe.
+ */
+[[nodiscard]] bool removal_is_valid(const std::vector<int>& levels,
+                                    const std::size_t first_violation,
+                                    const day2::DampenerRemoval removal) {
+    switch (removal) {
+        case day2::DampenerRemoval::not_needed: return reference_is_safe(levels);
+        case day2::DampenerRemoval::previous:
+            return first_violation >= 1 && reference_is_safe(without(levels, first_violation - 1));
+        case day2::DampenerRemoval::problem:
+            return first_violation < levels.size() &&
+                   reference_is_safe(without(levels, first_violation));
+        case day2::DampenerRemoval::first:
+            return !levels.empty() && reference_is_safe(without(levels, 0));
+        case day2::DampenerRemoval::failed: return !reference_is_dampened_safe(levels);
+    }
+    return false;
+}
+
+/**
+ * @brief Quotes a text for a mismatch description, escaping line breaks and unprintable bytes.
+ */
+[[nodiscard]] std::string quote(const std::string_view text) {
+    std::string quoted{'"'};
+    for (const char c : text) {
+        if (c == '\n') {
+            quoted += "\\n";
+        } else if (c == '\t') {
+            quoted += "\\t";
+        } else if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        } else if (c >= ' ' && c <= '~') {
+            quoted += c;
+        } else {
+            quoted += fmt::format("\\x{:02x}", static_cast<unsigned char>(c));
+        }
+    }
+    return quoted + '"';
+}
+
+[[nodiscard]] std::string format_reports(const std::vector<day2::Report>& reports) {
+    std::string text{};
+    for (const auto& report : reports)
+        text += fmt::format("{}\n", fmt::join(report.levels(), " "));
+    return text;
+}
+
+[[nodiscard]] bool same_reports(const std::vector<day2::Report>& a,
+                                const std::vector<day2::Report>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const day2::Report& x, const day2::Report& y) {
+                          return x.levels() == y.levels();
+                      });
+}
+
+}  // namespace
+
+Mismatch check_reports(const std::vector<day2::Report>& reports) {
+    const day2::ReportTable table{reports};
+    std::size_t safe_count{0};
+    std::size_t dampened_safe_count{0};
+
+    for (std::size_t i{0}; i < reports.size(); ++i) {
+        const auto& levels{reports[i].levels()};
+        const auto expected_violation{reference_first_violation(levels)};
+        const auto violation{day2::report_is_safe_until(reports[i])};
+        if (violation != expected_violation || table.summary(i).first_violation != violation)
+            return fmt::format("First violation of [{}]: reference {}, rows {}, table {}",
+                               fmt::join(levels, " "), expected_violation, violation,
+                               table.summary(i).first_violation);
+
+        const auto removal{day2::evaluate_problem_dampener(reports[i], violation)};
+        if (!removal_is_valid(levels, violation, removal) || table.removal(i) != removal)
+            return fmt::format("Dampener removal for [{}]: rows {}, table {}, reference {}",
+                               fmt::join(levels, " "), day2::dampener_removal_name(removal),
+                               day2::dampener_removal_name(table.removal(i)),
+                               reference_is_dampened_safe(levels) ? "safe" : "unsafe");
+
+        if (reference_is_safe(levels)) ++safe_count;
+        if (reference_is_dampened_safe(levels)) ++dampened_safe_count;
+    }
+
+    watch::ReportTotals totals{};
+    totals.add(reports);
+    const auto row_safe_count{static_cast<std::size_t>(day2::count_safe_reports(reports))};
+    const auto row_dampened_safe_count{
+        static_cast<std::size_t>(day2::count_safe_reports_with_problem_dampener(reports))};
+    if (row_safe_count != safe_count || table.count_safe() != safe_count ||
+        totals.safe_count() != safe_count)
+        return fmt::format("Safe count: reference {}, rows {}, table {}, watch {}", safe_count,
+                           row_safe_count, table.count_safe(), totals.safe_count());
+    if (row_dampened_safe_count != dampened_safe_count ||
+        table.count_safe_with_problem_dampener() != dampened_safe_count ||
+        totals.dampened_safe_count() != dampened_safe_count)
+        return fmt::format("Dampened safe count: reference {}, rows {}, table {}, watch {}",
+                           dampened_safe_count, row_dampened_safe_count,
+                           table.count_safe_with_problem_dampener(),
+                           totals.dampened_safe_count());
+    return std::nullopt;
+}
+
+Mismatch check_location_lists(const std::vector<int>& left_list,
+                              const std::vector<int>& right_list,
+                              const std::vector<std::size_t>& batch_sizes) {
+    auto sorted_left{left_list};
+    auto sorted_right{right_list};
+    std::sort(sorted_left.begin(), sorted_left.end());
+    std::sort(sorted_right.begin(), sorted_right.end());
+
+    std::vector<std::int64_t> expected_distances{};
+    std::int64_t expected_distance{0};
+    for (std::size_t i{0}; i < std::min(sorted_left.size(), sorted_right.size()); ++i) {
+        const auto difference{std::int64_t{sorted_left[i]} - sorted_right[i]};
+        expected_distances.push_back(difference < 0 ? -difference : difference);
+        expected_distance += expected_distances.back();
+    }
+
+    std::map<int, std::int64_t> right_counts{};
+    for (const int id : right_list) ++right_counts[id];
+    std::int64_t expected_similarity{0};
+    for (const int id : left_list) {
+        const auto count{right_counts.find(id)};
+        if (count != right_counts.end()) expected_similarity += std::int64_t{id} * count->second;
+    }
+
+    const auto distances{
+        day1::calculate_distances(std::vector{left_list}, std::vector{right_list})};
+    if (!std::equal(distances.begin(), distances.end(), expected_distances.begin(),
+                    expected_distances.end()))
+        return fmt::format("Distances of [{}] and [{}]: [{}] instead of [{}]",
+                           fmt::join(left_list, " "), fmt::join(right_list, " "),
+                           fmt::join(distances, " "), fmt::join(expected_distances, " "));
+
+    const auto distance{day1::sum_of_distances(sorted_left, sorted_right)};
+    if (distance != expected_distance)
+        return fmt::format("Total distance of [{}] and [{}]: {} instead of {}",
+                           fmt::join(left_list, " "), fmt::join(right_list, " "), distance,
+                           expected_distance);
+
+    // The original function returns an int, and documents that larger scores are truncated.
+    const auto truncated_similarity{static_cast<int>(expected_similarity)};
+    const auto similarity{day1::calculate_similarity_score(left_list, std::vector{right_list})};
+    if (similarity != truncated_similarity)
+        return fmt::format("Similarity of [{}] and [{}]: {} instead of {}",
+                           fmt::join(left_list, " "), fmt::join(right_list, " "), similarity,
+                           truncated_similarity);
+    const auto sorted_similarity{day1::calculate_similarity_score_sorted(left_list, sorted_right)};
+    if (sorted_similarity != expected_similarity)
+        return fmt::format("Sorted similarity of [{}] and [{}]: {} instead of {}",
+                           fmt::join(left_list, " "), fmt::join(right_list, " "),
+                           sorted_similarity, expected_similarity);
+
+    watch::LocationListTotals totals{};
+    std::size_t begin{0};
+    for (auto batch_size : batch_sizes) {
+        const auto end{std::min(begin + batch_size, left_list.size())};
+        const auto batch{[&](const std::vector<int>& list) {
+            return std::vector(list.begin() + static_cast<std::ptrdiff_t>(begin),
+                               list.begin() + static_cast<std::ptrdiff_t>(end));
+        }};
+        totals.add(batch(left_list), batch(right_list));
+        begin = end;
+    }
+    if (begin < left_list.size())
+        totals.add(std::vector(left_list.begin() + static_cast<std::ptrdiff_t>(begin),
+                               left_list.end()),
+                   std::vector(right_list.begin() + static_cast<std::ptrdiff_t>(begin),
+                               right_list.end()));
+    if (totals.total_distance() != expected_distance ||
+        totals.similarity_score() != expected_similarity)
+        return fmt::format("Watch totals of [{}] and [{}]: {} and {} instead of {} and {}",
+                           fmt::join(left_list, " "), fmt::join(right_list, " "),
+                           totals.total_distance(), totals.similarity_score(), expected_distance,
+                           expected_similarity);
+
+    std::string text{};
+    for (std::size_t i{0}; i < left_list.size(); ++i)
+        text += fmt::format("{}   {}\n", left_list[i], right_list[i]);
+    const auto parsed{day1::try_parse_location_lists(text, "generated")};
+    if (!parsed || parsed->first != left_list || parsed->second != right_list)
+        return fmt::format("Location lists did not survive parsing:\n{}", text);
+    return std::nullopt;
+}
+
+Mismatch check_reactor_data_text(const std::string_view text) {
+    const auto strict{day2::try_parse_reactor_data(text)};
+    const auto sequential{day2::parse_reactor_data_tolerant(text, {1, std::size_t{1} << 16})};
+    const auto parallel{day2::parse_reactor_data_tolerant(text, {3, 1})};
+
+    const bool same_errors{std::equal(
+        sequential.errors.begin(), sequential.errors.end(), parallel.errors.begin(),
+        parallel.errors.end(), [](const day2::LineError& a, const day2::LineError& b) {
+            return a.line_number == b.line_number && a.byte_offset == b.byte_offset;
+        })};
+    if (!same_reports(sequential.reports, parallel.reports) || !same_errors)
+        return fmt::format("Sequential and parallel tolerant parsing differ on {}", quote(text));
+
+    // The strict parser may accept lines with recoverable errors that the tolerant one skips,
+    // but it must fail whenever a line could not be parsed at all and agree otherwise.
+    if (sequential.errors.empty() &&
+        (!strict || !same_reports(*strict, sequential.reports)))
+        return fmt::format("Strict and tolerant parsing differ on {}", quote(text));
+    if (!strict) return std::nullopt;
+
+    // Parsed reports must read back the same, unless the strict parser recovered from an error.
+    if (sequential.errors.empty()) {
+        const auto formatted{format_reports(*strict)};
+        const auto reparsed{day2::try_parse_reactor_data(formatted)};
+        if (!reparsed || !same_reports(*reparsed, *strict))
+            return fmt::format("Reactor data did not survive parsing:\n{}", formatted);
+    }
+    return std::nullopt;
+}
+
+Mismatch check_location_lists_text(const std::string_view text) {
+    const auto parsed{day1::try_parse_location_lists(std::string{text}, "fuzz")};
+    if (!parsed) return std::nullopt;
+
+    std::string formatted{};
+    for (std::size_t i{0}; i < parsed->first.size(); ++i)
+        formatted += fmt::format("{}   {}\n", parsed->first[i], parsed->second[i]);
+    const auto reparsed{day1::try_parse_location_lists(formatted, "fuzz")};
+    if (!reparsed || *reparsed != *parsed)
+        return fmt::format("Location lists parsed from {} did not survive parsing:\n{}",
+                           quote(text), formatted);
+    return std::nullopt;
+}
+
+Mismatch check_input(const std::uint8_t* data, const std::size_t size) {
+    InputReader reader{data, size};
+    switch (reader.byte() % 4) {
+        case 0: return check_reports(decode_reports(reader));
+        case 1: {
+            std::vector<int> left_list(reader.byte() % (kMaxPairCount + 1));
+            std::vector<int> right_list(left_list.size());
+            for (std::size_t i{0}; i < left_list.size(); ++i) {
+                left_list[i] = next_location_id(reader);
+                right_list[i] = next_location_id(reader);
+            }
+            std::vector<std::size_t> batch_sizes{};
+            while (!reader.empty()) batch_sizes.push_back(reader.byte() % 32);
+            return check_location_lists(left_list, right_list, batch_sizes);
+        }
+        case 2: return check_reactor_data_text(decode_text(reader));
+        default: return check_location_lists_text(decode_text(reader));
+    }
+}
+
+std::vector<std::uint8_t> minimize_input(std::vector<std::uint8_t> input) {
+    const auto fails{[](const std::vector<std::uint8_t>& candidate) {
+        return check_input(candidate.data(), candidate.size()).has_value();
+    }};
+
+    for (bool shrunk{true}; shrunk;) {
+        shrunk = false;
+        for (auto run{std::max<std::size_t>(1, input.size() / 2)}; run > 0; run /= 2) {
+            for (std::size_t begin{0}; begin + run <= input.size();) {
+                auto candidate{input};
+                candidate.erase(candidate.begin() + static_cast<std::ptrdiff_t>(begin),
+                                candidate.begin() + static_cast<std::ptrdiff_t>(begin + run));
+                if (fails(candidate)) {
+                    input = std::move(candidate);
+                    shrunk = true;
+                } else {
+                    begin += run;
+                }
+            }
+        }
+        for (auto& value : input) {
+            for (const auto lower : {std::uint8_t{0}, static_cast<std::uint8_t>(value / 2)}) {
+                if (lower >= value) continue;
+                const auto original{std::exchange(value, lower)};
+                if (fails(input)) {
+                    shrunk = true;
+                    break;
+                }
+                value = original;
+            }
+        }
+    }
+    return input;
+}
+
+}  // namespace aoc24::fuzz
@@ -0,0 +1,93 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_FUZZ_DIFFERENTIAL_H_
+#define AOC24_CPP_FUZZ_DIFFERENTIAL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "day2/Report.h"
+
+namespace aoc24::fuzz {
+
+/**
+ * @brief Describes how the engines disagreed, or is empty if they all agreed.
+ */
+using Mismatch = std::optional<std::string>;
+
+/**
+ * @brief Compares every day 2 engine with a brute-force reference on the given reports.
+ *
+ * Covers @c report_is_safe_until, the problem dampener, the safe report counts,
+ * the columnar @c ReportTable and the incremental totals of watch mode.
+ * Levels may take any @c int value.
+ */
+[[nodiscard]] Mismatch check_reports(const std::vector<day2::Report>& reports);
+
+/**
+ * @brief Compares every day 1 engine with a reference on the given location lists.
+ *
+ * Covers @c calculate_distances, @c sum_of_distances, both similarity score functions
+ * and the incremental totals of watch mode, which receive the pairs in the given batches.
+ *
+ * @param left_list The left IDs, which are non-negative like the parser produces.
+ * @param right_list The right IDs, as many as there are left IDs.
+ * @param batch_sizes The number of pairs added to the incremental totals at a time.
+ */
+[[nodiscard]] Mismatch check_location_lists(const std::vector<int>& left_list,
+                                            const std::vector<int>& right_list,
+                                            const std::vector<std::size_t>& batch_sizes);
+
+/**
+ * @brief Compares the strict, per-line and parallel tolerant reactor data parsers on a text.
+ */
+[[nodiscard]] Mismatch check_reactor_data_text(std::string_view text);
+
+/**
+ * @brief Checks that the location list parser reads its own output back unchanged.
+ */
+[[nodiscard]] Mismatch check_location_lists_text(std::string_view text);
+
+/**
+ * @brief Decodes arbitrary bytes into one of the inputs above and checks it.
+ *
+ * The first byte selects the check, and the remaining bytes are decoded so that
+ * nearly safe reports, duplicate IDs and the extremes of @c int are all common.
+ *
+ * @param data The bytes to decode.
+ * @param size The number of bytes.
+ */
+[[nodiscard]] Mismatch check_input(const std::uint8_t* data, std::size_t size);
+
+/**
+ * @brief Shrinks an input for which @c check_input reports a mismatch while it keeps failing.
+ *
+ * Removes ever smaller runs of bytes, then lowers the remaining bytes,
+ * until no single step keeps the mismatch.
+ *
+ * @param input The failing input.
+ * @return The smallest failing input found.
+ */
+[[nodiscard]] std::vector<std::uint8_t> minimize_input(std::vector<std::uint8_t> input);
+
+}  // namespace aoc24::fuzz
+
+#endif  // AOC24_CPP_FUZZ_DIFFERENTIAL_H_
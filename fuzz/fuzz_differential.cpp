@@ -0,0 +1,49 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifndef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "differential.h"
+
+// Run with e.g. `aoc24_fuzz_differential -max_len=512 corpus/`, and shrink a crashing input with
+// `aoc24_fuzz_differential -minimize_crash=1 -runs=100000 crash-<hash>`.
+
+extern "C" int LLVMFuzzerInitialize(int*, char***) {
+    // Out of range similarity scores and recovered parse errors are expected here.
+    spdlog::set_level(spdlog::level::off);
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, const std::size_t size) {
+    const auto mismatch{aoc24::fuzz::check_input(data, size)};
+    if (mismatch) {
+        fmt::print(stderr, "{}\n", *mismatch);
+        std::abort();
+    }
+    return 0;
+}
@@ -117,6 +117,110 @@ class FileReadException final : public AocException {
     }
 };
 
+/**
+ * @brief Exception class for file write errors.
+ *
+ * This exception is thrown when a file operation such as creating or writing a file fails.
+ * It provides a detailed error message including the file path and the corresponding error reason.
+ */
+class FileWriteException final : public AocException {
+    const std::string message_{};
+
+  public:
+    /**
+     * @brief Constructs a FileWriteException from a file path and a system error number.
+     *
+     * @param file_path The path of the file that caused the error.
+     * @param error_num The system error number corresponding to the file operation failure.
+     */
+    FileWriteException(const std::filesystem::path& file_path, const int error_num) noexcept
+        : message_{create_message(file_path, std::strerror(error_num))} {}
+
+    /**
+     * @brief Returns a C-style string describing the error and its cause.
+     *
+     * This function is mainly included
+     * so that a message is shown upon termination when the exception is never caught.
+     * Use of @c error_message or @c user_message is preferred
+     * to get a string view describing the error.
+     *
+     * @return A pointer to a null-terminated string containing the error message.
+     */
+    [[nodiscard]] const char* what() const noexcept override { return message_.c_str(); }
+
+    /**
+     * @brief Retrieves the detailed error message written for logging.
+     * @return A string view representing the detailed error message.
+     */
+    [[nodiscard]] std::string_view error_message() const override { return message_; }
+
+    /**
+     * @brief Retrieves a user-friendly error message intended for displaying to end-users.
+     * @return A string view containing the user-friendly error message.
+     */
+    [[nodiscard]] std::string_view user_message() const override { return message_; }
+
+  private:
+    [[nodiscard]] static std::string create_message(
+        const std::filesystem::path& file_path, const std::string_view error_message) noexcept {
+        return "Failed to open or write file: " + file_path.string() + ": " +
+               std::string{error_message} + '.';
+    }
+};
+
+/**
+ * @brief Exception class for socket errors.
+ *
+ * This exception is thrown when a socket used by the query server cannot be set up or used.
+ */
+class SocketException final : public AocException {
+    const std::string message_{};
+
+  public:
+    /**
+     * @brief Constructs a SocketException from the failed operation and a system error number.
+     *
+     * @param operation What was being done, such as "bind".
+     * @param address The address of the socket.
+     * @param error_num The system error number corresponding to the failure.
+     */
+    SocketException(const std::string_view operation, const std::string_view address,
+                    const int error_num) noexcept
+        : message_{create_message(operation, address, std::strerror(error_num))} {}
+
+    /**
+     * @brief Returns a C-style string describing the error and its cause.
+     *
+     * This function is mainly included
+     * so that a message is shown upon termination when the exception is never caught.
+     * Use of @c error_message or @c user_message is preferred
+     * to get a string view describing the error.
+     *
+     * @return A pointer to a null-terminated string containing the error message.
+     */
+    [[nodiscard]] const char* what() const noexcept override { return message_.c_str(); }
+
+    /**
+     * @brief Retrieves the detailed error message written for logging.
+     * @return A string view representing the detailed error message.
+     */
+    [[nodiscard]] std::string_view error_message() const override { return message_; }
+
+    /**
+     * @brief Retrieves a user-friendly error message intended for displaying to end-users.
+     * @return A string view containing the user-friendly error message.
+     */
+    [[nodiscard]] std::string_view user_message() const override { return message_; }
+
+  private:
+    [[nodiscard]] static std::string create_message(
+        const std::string_view operation, const std::string_view address,
+        const std::string_view error_message) noexcept {
+        return "Failed to " + std::string{operation} + " socket " + std::string{address} + ": " +
+               std::string{error_message} + '.';
+    }
+};
+
 /**
  * @brief Exception class for parsing errors.
  *
@@ -165,6 +269,92 @@ class ParseException final : public AocException {
     [[nodiscard]] std::string_view user_message() const override { return user_message_; }
 };
 
+/**
+ * @brief Exception class for invalid command line usage.
+ *
+ * This exception is thrown when the command line arguments cannot be interpreted.
+ * The same message is used for logging and for displaying to end-users.
+ */
+class UsageException final : public AocException {
+    const std::string message_{};
+
+  public:
+    /**
+     * @brief Constructs a UsageException with a message describing the invalid usage.
+     *
+     * @param message A description of what was wrong with the arguments.
+     */
+    explicit UsageException(const std::string_view message) noexcept
+        : message_{"Invalid usage: " + std::string{message} + '.'} {}
+
+    /**
+     * @brief Returns a C-style string describing the error and its cause.
+     *
+     * This function is mainly included
+     * so that a message is shown upon termination when the exception is never caught.
+     * Use of @c error_message or @c user_message is preferred
+     * to get a string view describing the error.
+     *
+     * @return A pointer to a null-terminated string containing the error message.
+     */
+    [[nodiscard]] const char* what() const noexcept override { return message_.c_str(); }
+
+    /**
+     * @brief Retrieves the detailed error message written for logging.
+     * @return A string view representing the detailed error message.
+     */
+    [[nodiscard]] std::string_view error_message() const override { return message_; }
+
+    /**
+     * @brief Retrieves a user-friendly error message intended for displaying to end-users.
+     * @return A string view containing the user-friendly error message.
+     */
+    [[nodiscard]] std::string_view user_message() const override { return message_; }
+};
+
+/**
+ * @brief Exception class for failures of worker processes.
+ *
+ * This exception is thrown when a worker process cannot be started or does not exit successfully.
+ */
+class WorkerException final : public AocException {
+    const std::string error_message_{};
+    static constexpr auto user_message_{"A worker process failed. See the log for details."};
+
+  public:
+    /**
+     * @brief Constructs a WorkerException with a detailed error message.
+     *
+     * @param error_message A description of which worker failed and how.
+     */
+    explicit WorkerException(const std::string_view error_message) noexcept
+        : error_message_{error_message} {}
+
+    /**
+     * @brief Returns a C-style string describing the error and its cause.
+     *
+     * This function is mainly included
+     * so that a message is shown upon termination when the exception is never caught.
+     * Use of @c error_message or @c user_message is preferred
+     * to get a string view describing the error.
+     *
+     * @return A pointer to a null-terminated string containing the error message.
+     */
+    [[nodiscard]] const char* what() const noexcept override { return error_message_.c_str(); }
+
+    /**
+     * @brief Retrieves the detailed error message written for logging.
+     * @return A string view representing the detailed error message.
+     */
+    [[nodiscard]] std::string_view error_message() const override { return error_message_; }
+
+    /**
+     * @brief Retrieves a user-friendly error message intended for displaying to end-users.
+     * @return A string view containing the user-friendly error message.
+     */
+    [[nodiscard]] std::string_view user_message() const override { return user_message_; }
+};
+
 /**
  * @brief Exception class for overflow errors.
  *
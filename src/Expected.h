@@ -0,0 +1,266 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_EXPECTED_H_
+#define AOC24_CPP_SRC_EXPECTED_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "AocException.h"
+
+namespace aoc24 {
+
+/**
+ * @brief Identifies the kind of error that occurred.
+ *
+ * Each code corresponds to one of the exception classes in AocException.h.
+ */
+enum class ErrorCode {
+    /** A file could not be opened or read. See @c FileReadException. */
+    file_read,
+    /** A file could not be opened or written. See @c FileWriteException. */
+    file_write,
+    /** The input could not be parsed. See @c ParseException. */
+    parse,
+    /** An integer overflow was detected. See @c OverflowException. */
+    overflow,
+};
+
+/**
+ * @brief An error value that can be returned instead of throwing an exception.
+ *
+ * Only the data needed to describe the error is stored when it is created.
+ * The message is formatted when it is requested,
+ * so creating and discarding errors is cheap.
+ */
+class AocError final {
+    ErrorCode code_{};
+    std::filesystem::path file_path_{};
+    int error_num_{};
+    std::size_t value_{};
+    std::string detail_{};
+
+    explicit AocError(const ErrorCode code) noexcept : code_{code} {}
+
+  public:
+    /**
+     * @brief Creates an error for a failed file read.
+     *
+     * @param file_path The path of the file that caused the error.
+     * @param error_num The system error number corresponding to the failure.
+     * @return The error.
+     */
+    [[nodiscard]] static AocError file_read(const std::filesystem::path& file_path,
+                                            const int error_num) {
+        AocError error{ErrorCode::file_read};
+        error.file_path_ = file_path;
+        error.error_num_ = error_num;
+        return error;
+    }
+
+    /**
+     * @brief Creates an error for a failed file write.
+     *
+     * @param file_path The path of the file that caused the error.
+     * @param error_num The system error number corresponding to the failure.
+     * @return The error.
+     */
+    [[nodiscard]] static AocError file_write(const std::filesystem::path& file_path,
+                                             const int error_num) {
+        AocError error{ErrorCode::file_write};
+        error.file_path_ = file_path;
+        error.error_num_ = error_num;
+        return error;
+    }
+
+    /**
+     * @brief Creates an error for input that could not be parsed.
+     *
+     * @param parser_report The description of the problem produced by the parser.
+     * @return The error.
+     */
+    [[nodiscard]] static AocError parse(std::string parser_report) {
+        AocError error{ErrorCode::parse};
+        error.detail_ = std::move(parser_report);
+        return error;
+    }
+
+    /**
+     * @brief Creates an error for an index that does not fit in the type it is converted to.
+     *
+     * @param index The offending index.
+     * @return The error.
+     */
+    [[nodiscard]] static AocError index_overflow(const std::size_t index) noexcept {
+        AocError error{ErrorCode::overflow};
+        error.value_ = index;
+        return error;
+    }
+
+    /**
+     * @brief Get the kind of error.
+     *
+     * @return The error code.
+     */
+    [[nodiscard]] ErrorCode code() const noexcept { return code_; }
+
+    /**
+     * @brief Formats the detailed error message written for logging.
+     *
+     * @return The same message the corresponding exception would carry.
+     */
+    [[nodiscard]] std::string message() const {
+        switch (code_) {
+            case ErrorCode::file_read:
+                return FileReadException{file_path_, error_num_}.what();
+            case ErrorCode::file_write:
+                return FileWriteException{file_path_, error_num_}.what();
+            case ErrorCode::parse: return detail_;
+            case ErrorCode::overflow:
+                return OverflowException{overflow_detail()}.what();
+        }
+        return {};
+    }
+
+    /**
+     * @brief Throws the exception corresponding to this error.
+     *
+     * @throws FileReadException, FileWriteException, ParseException or OverflowException
+     *         Depending on the error code.
+     */
+    [[noreturn]] void raise() const {
+        switch (code_) {
+            case ErrorCode::file_read: throw FileReadException{file_path_, error_num_};
+            case ErrorCode::file_write: throw FileWriteException{file_path_, error_num_};
+            case ErrorCode::parse: throw ParseException{detail_};
+            case ErrorCode::overflow: break;
+        }
+        throw OverflowException{overflow_detail()};
+    }
+
+  private:
+    [[nodiscard]] std::string overflow_detail() const {
+        return "Problem index is out of range. Index was: " + std::to_string(value_);
+    }
+};
+
+/**
+ * @brief Holds either a value of type T or an @c AocError.
+ *
+ * A minimal C++17 stand-in for @c std::expected.
+ *
+ * @tparam T The type of the value.
+ */
+template <typename T>
+class Expected final {
+    static_assert(!std::is_same_v<T, AocError>, "The value type cannot be the error type.");
+
+    std::variant<T, AocError> storage_;
+
+  public:
+    /**
+     * @brief Constructs an @c Expected holding a copy of a value.
+     *
+     * @param value The value.
+     */
+    Expected(const T& value) : storage_{std::in_place_index<0>, value} {}
+
+    /**
+     * @brief Constructs an @c Expected by moving a value into it.
+     *
+     * @param value The value.
+     */
+    Expected(T&& value) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : storage_{std::in_place_index<0>, std::move(value)} {}
+
+    /**
+     * @brief Constructs an @c Expected holding a copy of an error.
+     *
+     * @param error The error.
+     */
+    Expected(const AocError& error) : storage_{std::in_place_index<1>, error} {}
+
+    /**
+     * @brief Constructs an @c Expected by moving an error into it.
+     *
+     * @param error The error.
+     */
+    Expected(AocError&& error) noexcept : storage_{std::in_place_index<1>, std::move(error)} {}
+
+    /**
+     * @brief Checks whether a value is held.
+     *
+     * @return True if a value is held, false if an error is held.
+     */
+    [[nodiscard]] bool has_value() const noexcept { return storage_.index() == 0; }
+
+    /**
+     * @brief Checks whether a value is held.
+     *
+     * @return True if a value is held, false if an error is held.
+     */
+    explicit operator bool() const noexcept { return has_value(); }
+
+    /**
+     * @brief Get the held value. The behavior is undefined if an error is held.
+     *
+     * @return A reference to the value.
+     */
+    [[nodiscard]] const T& operator*() const& noexcept { return *std::get_if<0>(&storage_); }
+
+    /**
+     * @brief Get the held value. The behavior is undefined if an error is held.
+     *
+     * @return A reference to the value.
+     */
+    [[nodiscard]] T& operator*() & noexcept { return *std::get_if<0>(&storage_); }
+
+    /**
+     * @brief Access a member of the held value. The behavior is undefined if an error is held.
+     *
+     * @return A pointer to the value.
+     */
+    [[nodiscard]] const T* operator->() const noexcept { return std::get_if<0>(&storage_); }
+
+    /**
+     * @brief Get the held error. The behavior is undefined if a value is held.
+     *
+     * @return A reference to the error.
+     */
+    [[nodiscard]] const AocError& error() const noexcept { return *std::get_if<1>(&storage_); }
+
+    /**
+     * @brief Takes the held value, or throws the exception corresponding to the held error.
+     *
+     * This is how the throwing wrappers of the expected-style functions are implemented.
+     *
+     * @return The value.
+     * @throws AocException The exception corresponding to the held error, if there is one.
+     */
+    [[nodiscard]] T value_or_throw() && {
+        if (!has_value()) error().raise();
+        return std::move(*std::get_if<0>(&storage_));
+    }
+};
+
+}  // namespace aoc24
+
+#endif  // AOC24_CPP_SRC_EXPECTED_H_
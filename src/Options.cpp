@@ -0,0 +1,227 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Options.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+#include <string>
+#include <string_view>
+
+#include "AocException.h"
+
+namespace aoc24 {
+
+namespace {
+
+/**
+ * @brief Cursor over the command line arguments.
+ */
+class ArgumentCursor final {
+    int argc_{};
+    const char* const* argv_{};
+    int index_{1};
+
+  public:
+    ArgumentCursor(const int argc, const char* const argv[]) : argc_{argc}, argv_{argv} {}
+
+    [[nodiscard]] bool done() const { return index_ >= argc_; }
+
+    [[nodiscard]] std::string_view next() { return argv_[index_++]; }
+
+    [[nodiscard]] std::string_view value_for(const std::string_view option) {
+        if (done()) throw UsageException{"Missing value for " + std::string{option}};
+        return next();
+    }
+};
+
+[[nodiscard]] day2::DiagnosticsFormat parse_diagnostics_format(const std::string_view value) {
+    if (value == "text") return day2::DiagnosticsFormat::text;
+    if (value == "binary") return day2::DiagnosticsFormat::binary;
+    throw UsageException{"Unknown diagnostics format: " + std::string{value}};
+}
+
+[[nodiscard]] std::size_t parse_count(const std::string_view option,
+                                      const std::string_view value) {
+    std::size_t count{};
+    const auto [end, error]{std::from_chars(value.data(), value.data() + value.size(), count)};
+    if (error != std::errc{} || end != value.data() + value.size())
+        throw UsageException{"Expected a non-negative number for " + std::string{option} +
+                             ", got: " + std::string{value}};
+    return count;
+}
+
+[[nodiscard]] std::uint32_t parse_count32(const std::string_view option,
+                                          const std::string_view value) {
+    const auto count{parse_count(option, value)};
+    if (count > std::numeric_limits<std::uint32_t>::max())
+        throw UsageException{"Expected a number up to " +
+                             std::to_string(std::numeric_limits<std::uint32_t>::max()) + " for " +
+                             std::string{option} + ", got: " + std::string{value}};
+    return static_cast<std::uint32_t>(count);
+}
+
+[[nodiscard]] double parse_fraction(const std::string_view option, const std::string_view value) {
+    double fraction{};
+    const auto [end, error]{std::from_chars(value.data(), value.data() + value.size(), fraction)};
+    if (error != std::errc{} || end != value.data() + value.size() || fraction <= 0.0 ||
+        fraction >= 1.0)
+        throw UsageException{"Expected a number between 0 and 1 for " + std::string{option} +
+                             ", got: " + std::string{value}};
+    return fraction;
+}
+
+[[nodiscard]] logging::LogMode parse_log_mode(const std::string_view value) {
+    if (value == "sync") return logging::LogMode::sync;
+    if (value == "async") return logging::LogMode::async;
+    throw UsageException{"Unknown log mode: " + std::string{value}};
+}
+
+[[nodiscard]] logging::OverflowPolicy parse_overflow_policy(const std::string_view value) {
+    if (value == "block") return logging::OverflowPolicy::block;
+    if (value == "overrun") return logging::OverflowPolicy::overrun_oldest;
+    throw UsageException{"Unknown log overflow policy: " + std::string{value}};
+}
+
+}  // namespace
+
+Options parse_options(const int argc, const char* const argv[]) {
+    Options options{};
+    ArgumentCursor arguments{argc, argv};
+
+    while (!arguments.done()) {
+        const auto argument{arguments.next()};
+
+        if (argument == "--day") {
+            const auto day{parse_count(argument, arguments.value_for(argument))};
+            if (day != 1 && day != 2) throw UsageException{"Only days 1 and 2 are solved"};
+            options.day = static_cast<int>(day);
+        } else if (argument == "--input") {
+            options.input_path = std::filesystem::path{arguments.value_for(argument)};
+        } else if (argument == "--external-sort") {
+            options.external_sort = true;
+        } else if (argument == "--memory-budget") {
+            options.external_sort_config.memory_budget =
+                parse_count(argument, arguments.value_for(argument));
+        } else if (argument == "--merge-fan-in") {
+            options.external_sort_config.max_merge_fan_in =
+                parse_count(argument, arguments.value_for(argument));
+        } else if (argument == "--temp-dir") {
+            options.external_sort_config.temp_dir =
+                std::filesystem::path{arguments.value_for(argument)};
+        } else if (argument == "--sketch") {
+            options.sketch = true;
+        } else if (argument == "--sketch-epsilon") {
+            options.sketch_config.epsilon =
+                parse_fraction(argument, arguments.value_for(argument));
+        } else if (argument == "--sketch-delta") {
+            options.sketch_config.delta = parse_fraction(argument, arguments.value_for(argument));
+        } else if (argument == "--heavy-hitters") {
+            options.sketch_config.heavy_hitter_capacity =
+                parse_count(argument, arguments.value_for(argument));
+        } else if (argument == "--diagnostics") {
+            options.diagnostics_path = std::filesystem::path{arguments.value_for(argument)};
+        } else if (argument == "--diagnostics-format") {
+            options.diagnostics_format = parse_diagnostics_format(arguments.value_for(argument));
+        } else if (argument == "--log-mode") {
+            options.logger.mode = parse_log_mode(arguments.value_for(argument));
+        } else if (argument == "--log-level") {
+            const auto level{arguments.value_for(argument)};
+            if (!logging::is_valid_level(level))
+                throw UsageException{"Unknown log level: " + std::string{level}};
+            options.logger.level = std::string{level};
+        } else if (argument == "--log-queue-size") {
+            options.logger.queue_size = parse_count(argument, arguments.value_for(argument));
+            if (options.logger.queue_size == 0)
+                throw UsageException{"The log queue size must be positive"};
+        } else if (argument == "--log-threads") {
+            options.logger.thread_count = parse_count(argument, arguments.value_for(argument));
+            if (options.logger.thread_count == 0)
+                throw UsageException{"The number of log threads must be positive"};
+        } else if (argument == "--log-overflow") {
+            options.logger.overflow_policy = parse_overflow_policy(arguments.value_for(argument));
+        } else if (argument == "--parse-error-burst") {
+            options.logger.parse_error_burst =
+                parse_count32(argument, arguments.value_for(argument));
+        } else if (argument == "--parse-errors-per-second") {
+            options.logger.parse_errors_per_second =
+                parse_count32(argument, arguments.value_for(argument));
+        } else if (argument == "--stats") {
+            options.stats = true;
+        } else if (argument == "--columnar") {
+            options.columnar = true;
+        } else if (argument == "--recover") {
+            options.recover_parse_errors = true;
+        } else if (argument == "--threads") {
+            options.parse_recovery.thread_count =
+                parse_count(argument, arguments.value_for(argument));
+        } else if (argument == "--shards") {
+            options.shard_count = parse_count(argument, arguments.value_for(argument));
+        } else if (argument == "--shard-range") {
+            const auto start{parse_count(argument, arguments.value_for(argument))};
+            const auto end{parse_count(argument, arguments.value_for(argument))};
+            if (start > end) throw UsageException{"The shard range must not end before it starts"};
+            options.shard_range = shard::ByteRange{start, end};
+        } else if (argument == "--partial") {
+            options.partial_path = std::filesystem::path{arguments.value_for(argument)};
+        } else if (argument == "--work-dir") {
+            options.work_dir = std::filesystem::path{arguments.value_for(argument)};
+        } else if (argument == "--serve") {
+            const auto address{arguments.value_for(argument)};
+            const auto server_address{server::parse_server_address(address)};
+            if (!server_address)
+                throw UsageException{"Expected unix:PATH or tcp:PORT for --serve, got: " +
+                                     std::string{address}};
+            options.serve = true;
+            options.server_config.address = *server_address;
+        } else if (argument == "--location-lists") {
+            options.server_config.location_lists_path =
+                std::filesystem::path{arguments.value_for(argument)};
+        } else if (argument == "--reactor-data") {
+            options.server_config.reactor_data_path =
+                std::filesystem::path{arguments.value_for(argument)};
+        } else if (argument == "--reload-interval") {
+            const auto milliseconds{parse_count(argument, arguments.value_for(argument))};
+            if (milliseconds == 0 || milliseconds > 60'000)
+                throw UsageException{"The reload interval must be between 1 and 60000 ms"};
+            options.server_config.reload_check_interval = std::chrono::milliseconds{milliseconds};
+        } else if (argument == "--watch") {
+            options.watch = true;
+        } else if (argument == "--debounce") {
+            options.watch_config.debounce =
+                std::chrono::milliseconds{parse_count(argument, arguments.value_for(argument))};
+        } else if (argument == "--max-latency") {
+            options.watch_config.max_latency =
+                std::chrono::milliseconds{parse_count(argument, arguments.value_for(argument))};
+        } else {
+            throw UsageException{"Unknown argument: " + std::string{argument}};
+        }
+    }
+
+    if (options.shard_range && !options.partial_path)
+        throw UsageException{"--shard-range requires --partial"};
+    if (options.stats && (options.external_sort || options.sketch || options.shard_count > 0 ||
+                          options.shard_range || options.serve || options.watch))
+        throw UsageException{"--stats only applies to solving in memory without sharding"};
+
+    return options;
+}
+
+}  // namespace aoc24
@@ -0,0 +1,157 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_OPTIONS_H_
+#define AOC24_CPP_SRC_OPTIONS_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+
+#include "day1/FrequencySketch.h"
+#include "day1/external_sort.h"
+#include "day2/diagnostics.h"
+#include "logging.h"
+#include "server/server.h"
+#include "shard/shard.h"
+#include "watch/watch.h"
+
+namespace aoc24 {
+
+/**
+ * @brief The settings selected on the command line.
+ */
+struct Options {
+    /**
+     * @brief The puzzle day to solve, 1 or 2.
+     */
+    int day{2};
+
+    /**
+     * @brief The input file, if it differs from the default for the day.
+     */
+    std::optional<std::filesystem::path> input_path{};
+
+    /**
+     * @brief Whether day 1 is solved with bounded memory by spilling sorted runs to disk.
+     */
+    bool external_sort{false};
+
+    /**
+     * @brief The memory and spill settings for the external sort.
+     */
+    day1::ExternalSortConfig external_sort_config{};
+
+    /**
+     * @brief Whether the day 1 similarity score is approximated with bounded memory.
+     */
+    bool sketch{false};
+
+    /**
+     * @brief The size and accuracy settings for the approximation.
+     */
+    day1::SketchConfig sketch_config{};
+
+    /**
+     * @brief Where to write per-report diagnostics for unsafe reports, if anywhere.
+     */
+    std::optional<std::filesystem::path> diagnostics_path{};
+
+    /**
+     * @brief The encoding of the diagnostics file.
+     */
+    day2::DiagnosticsFormat diagnostics_format{day2::DiagnosticsFormat::text};
+
+    /**
+     * @brief The logging backend settings.
+     */
+    logging::LoggerConfig logger{};
+
+    /**
+     * @brief Whether to print the time, hardware event counts and peak memory of each phase
+     *        of the solution.
+     */
+    bool stats{false};
+
+    /**
+     * @brief Whether day 2 reports are evaluated once into a columnar table.
+     */
+    bool columnar{false};
+
+    /**
+     * @brief Whether malformed input lines are skipped instead of aborting the run.
+     */
+    bool recover_parse_errors{false};
+
+    /**
+     * @brief The parallelism settings for error-tolerant parsing.
+     */
+    day2::ParseRecoveryConfig parse_recovery{};
+
+    /**
+     * @brief The number of local worker processes to shard the input over, or zero to not shard.
+     */
+    std::size_t shard_count{0};
+
+    /**
+     * @brief The byte range to process when running as a shard worker.
+     */
+    std::optional<shard::ByteRange> shard_range{};
+
+    /**
+     * @brief Where a shard worker writes its partial result.
+     */
+    std::optional<std::filesystem::path> partial_path{};
+
+    /**
+     * @brief The directory for partial results, or empty for a temporary directory.
+     */
+    std::optional<std::filesystem::path> work_dir{};
+
+    /**
+     * @brief Whether to run as a query server instead of solving once.
+     */
+    bool serve{false};
+
+    /**
+     * @brief The address, inputs and reload settings of the query server.
+     */
+    server::ServerConfig server_config{};
+
+    /**
+     * @brief Whether to solve again whenever the input file changes.
+     */
+    bool watch{false};
+
+    /**
+     * @brief The batching settings of watch mode.
+     */
+    watch::WatchConfig watch_config{};
+};
+
+/**
+ * @brief Parses the command line arguments.
+ *
+ * @param argc The number of arguments, including the program name.
+ * @param argv The arguments, including the program name.
+ * @return The parsed settings.
+ * @throws UsageException If an argument is unknown or malformed.
+ */
+[[nodiscard]] Options parse_options(int argc, const char* const argv[]);
+
+}  // namespace aoc24
+
+#endif  // AOC24_CPP_SRC_OPTIONS_H_
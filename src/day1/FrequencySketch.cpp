@@ -0,0 +1,189 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "FrequencySketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace aoc24::day1 {
+
+namespace {
+
+constexpr std::size_t kMinWidth{16};
+
+[[nodiscard]] std::uint64_t split_mix(std::uint64_t& state) {
+    state += 0x9E3779B97F4A7C15ULL;
+    auto z{state};
+    z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31U);
+}
+
+}  // namespace
+
+FrequencySketch::FrequencySketch(const SketchConfig& config)
+    : heavy_hitter_capacity_{config.heavy_hitter_capacity} {
+    // Count-Min needs a width of e / epsilon and a depth of ln(1 / delta).
+    // The width is rounded up to a power of two so buckets can be selected with a shift.
+    const auto min_width{std::max(static_cast<double>(kMinWidth),
+                                  std::ceil(std::exp(1.0) / std::max(config.epsilon, 1e-9)))};
+    unsigned width_bits{0};
+    while ((std::size_t{1} << width_bits) < static_cast<std::size_t>(min_width)) ++width_bits;
+    width_mask_ = (std::size_t{1} << width_bits) - 1;
+    width_shift_ = 64U - width_bits;
+    const auto delta{std::clamp(config.delta, 1e-12, 0.5)};
+    depth_ = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(std::log(1.0 / delta))));
+
+    auto state{config.seed};
+    for (std::size_t row{0}; row < depth_; ++row) {
+        // Multiply-add-shift hashing needs an odd multiplier.
+        hash_multipliers_.push_back(split_mix(state) | 1U);
+        hash_offsets_.push_back(split_mix(state));
+    }
+
+    counters_.assign(depth_ * (width_mask_ + 1), 0);
+    heavy_hitters_.reserve(heavy_hitter_capacity_);
+    heavy_hitter_index_.reserve(heavy_hitter_capacity_);
+}
+
+std::size_t FrequencySketch::bucket(const std::size_t row, const int id) const {
+    const auto key{static_cast<std::uint64_t>(static_cast<std::uint32_t>(id))};
+    const auto hash{(hash_multipliers_[row] * key + hash_offsets_[row]) >> width_shift_};
+    return row * (width_mask_ + 1) + (static_cast<std::size_t>(hash) & width_mask_);
+}
+
+void FrequencySketch::add_to_sketch(const int id, const std::int64_t weight) {
+    for (std::size_t row{0}; row < depth_; ++row) counters_[bucket(row, id)] += weight;
+    sketched_weight_ += weight;
+}
+
+void FrequencySketch::add(const int id, const std::int64_t weight) {
+    if (const auto it{heavy_hitter_index_.find(id)}; it != heavy_hitter_index_.end()) {
+        heavy_hitters_[it->second].count += weight;
+        sift_down(it->second);
+        return;
+    }
+
+    // The table only has room before anything was ever sketched,
+    // so IDs admitted here have no weight in the sketch and are counted exactly.
+    if (heavy_hitters_.size() < heavy_hitter_capacity_) {
+        heavy_hitters_.push_back({id, weight, 0, true});
+        heavy_hitter_index_.emplace(id, heavy_hitters_.size() - 1);
+        sift_up(heavy_hitters_.size() - 1);
+        return;
+    }
+
+    add_to_sketch(id, weight);
+    if (heavy_hitters_.empty()) return;
+
+    // Promote the ID if it overtook the smallest exact counter.
+    const auto estimated_weight{sketched_estimate(id)};
+    if (estimated_weight <= heavy_hitters_.front().key()) return;
+
+    const auto evicted{heavy_hitters_.front()};
+    add_to_sketch(evicted.id, evicted.count);
+    heavy_hitter_index_.erase(evicted.id);
+    heavy_hitters_.front() = {id, 0, estimated_weight, false};
+    heavy_hitter_index_.emplace(id, 0);
+    sift_down(0);
+}
+
+std::int64_t FrequencySketch::sketched_estimate(const int id) const {
+    if (const auto it{heavy_hitter_index_.find(id)};
+        it != heavy_hitter_index_.end() && heavy_hitters_[it->second].exact)
+        return 0;
+
+    auto estimated_weight{std::numeric_limits<std::int64_t>::max()};
+    for (std::size_t row{0}; row < depth_; ++row)
+        estimated_weight = std::min(estimated_weight, counters_[bucket(row, id)]);
+    return estimated_weight;
+}
+
+std::int64_t FrequencySketch::estimate(const int id) const {
+    const auto it{heavy_hitter_index_.find(id)};
+    if (it == heavy_hitter_index_.end()) return sketched_estimate(id);
+    return heavy_hitters_[it->second].count + sketched_estimate(id);
+}
+
+bool FrequencySketch::is_exact(const int id) const {
+    const auto it{heavy_hitter_index_.find(id)};
+    return it != heavy_hitter_index_.end() && heavy_hitters_[it->second].exact;
+}
+
+double FrequencySketch::sketched_inner_product(const FrequencySketch& other) const {
+    const auto width{width_mask_ + 1};
+    auto inner_product{std::numeric_limits<double>::max()};
+
+    for (std::size_t row{0}; row < depth_; ++row) {
+        double row_product{0.0};
+        for (std::size_t i{row * width}; i < (row + 1) * width; ++i)
+            row_product +=
+                static_cast<double>(counters_[i]) * static_cast<double>(other.counters_[i]);
+        inner_product = std::min(inner_product, row_product);
+    }
+
+    return inner_product;
+}
+
+std::size_t FrequencySketch::memory_usage() const {
+    // Each hash map entry costs a node with the key, value and next pointer,
+    // plus a bucket pointer.
+    constexpr std::size_t kIndexEntrySize{sizeof(void*) * 2 + sizeof(int) + sizeof(std::size_t)};
+    return counters_.capacity() * sizeof(std::int64_t) +
+           (hash_multipliers_.capacity() + hash_offsets_.capacity()) * sizeof(std::uint64_t) +
+           heavy_hitters_.capacity() * sizeof(HeavyHitter) +
+           heavy_hitter_index_.bucket_count() * sizeof(void*) +
+           heavy_hitter_index_.size() * kIndexEntrySize;
+}
+
+void FrequencySketch::swap_heavy_hitters(const std::size_t a, const std::size_t b) {
+    std::swap(heavy_hitters_[a], heavy_hitters_[b]);
+    heavy_hitter_index_[heavy_hitters_[a].id] = a;
+    heavy_hitter_index_[heavy_hitters_[b].id] = b;
+}
+
+void FrequencySketch::sift_up(std::size_t index) {
+    while (index > 0) {
+        const auto parent{(index - 1) / 2};
+        if (heavy_hitters_[parent].key() <= heavy_hitters_[index].key()) return;
+        swap_heavy_hitters(parent, index);
+        index = parent;
+    }
+}
+
+void FrequencySketch::sift_down(std::size_t index) {
+    for (;;) {
+        const auto left{2 * index + 1};
+        const auto right{left + 1};
+        auto smallest{index};
+        if (left < heavy_hitters_.size() &&
+            heavy_hitters_[left].key() < heavy_hitters_[smallest].key())
+            smallest = left;
+        if (right < heavy_hitters_.size() &&
+            heavy_hitters_[right].key() < heavy_hitters_[smallest].key())
+            smallest = right;
+        if (smallest == index) return;
+        swap_heavy_hitters(index, smallest);
+        index = smallest;
+    }
+}
+
+}  // namespace aoc24::day1
@@ -0,0 +1,176 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_DAY1_FREQUENCY_SKETCH_H_
+#define AOC24_CPP_SRC_DAY1_FREQUENCY_SKETCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace aoc24::day1 {
+
+/**
+ * @brief The size and accuracy settings of a frequency sketch.
+ */
+struct SketchConfig {
+    /**
+     * @brief The relative error of a point estimate, as a fraction of the total sketched weight.
+     */
+    double epsilon{1e-4};
+
+    /**
+     * @brief The probability that an estimate exceeds its error bound.
+     */
+    double delta{1e-3};
+
+    /**
+     * @brief The number of heavy hitters that are counted exactly.
+     */
+    std::size_t heavy_hitter_capacity{1024};
+
+    /**
+     * @brief The seed for the hash functions. Sketches can only be combined if their seeds match.
+     */
+    std::uint64_t seed{0x9E3779B97F4A7C15ULL};
+};
+
+/**
+ * @brief Bounded-memory frequency estimator for a stream of location IDs.
+ *
+ * The most frequent IDs are kept in a small table of exact counters.
+ * All other weight goes into a Count-Min sketch,
+ * whose estimates never undercount and overcount by at most
+ * @c epsilon times the total sketched weight with probability @c 1 - delta.
+ * An ID whose sketched estimate overtakes the smallest exact counter replaces it,
+ * and the replaced counter is folded into the sketch.
+ * IDs that were admitted to the table on first sight and never left it are counted exactly.
+ *
+ * Weights must be non-negative.
+ */
+class FrequencySketch final {
+  public:
+    /**
+     * @brief An ID that is tracked in the table of exact counters.
+     */
+    struct HeavyHitter {
+        /** The location ID. */
+        int id{};
+        /** The weight added since the ID entered the table. */
+        std::int64_t count{};
+        /** The sketched estimate of the ID when it entered the table. */
+        std::int64_t base{};
+        /** Whether the ID never had any weight in the sketch. */
+        bool exact{};
+
+        /** The key the table is ordered by. */
+        [[nodiscard]] std::int64_t key() const { return base + count; }
+    };
+
+  private:
+    std::size_t width_mask_{};
+    unsigned width_shift_{};
+    std::size_t depth_{};
+    std::vector<std::uint64_t> hash_multipliers_{};
+    std::vector<std::uint64_t> hash_offsets_{};
+    std::vector<std::int64_t> counters_{};
+    std::int64_t sketched_weight_{};
+
+    std::size_t heavy_hitter_capacity_{};
+    std::vector<HeavyHitter> heavy_hitters_{};
+    std::unordered_map<int, std::size_t> heavy_hitter_index_{};
+
+  public:
+    /**
+     * @brief Constructs an empty sketch.
+     *
+     * @param config The size and accuracy settings.
+     */
+    explicit FrequencySketch(const SketchConfig& config);
+
+    /**
+     * @brief Adds an occurrence of an ID to the sketch.
+     *
+     * @param id The location ID.
+     * @param weight The weight of the occurrence.
+     */
+    void add(int id, std::int64_t weight = 1);
+
+    /**
+     * @brief Estimates the total weight of an ID.
+     *
+     * @param id The location ID.
+     * @return An estimate that is never lower than the true weight.
+     */
+    [[nodiscard]] std::int64_t estimate(int id) const;
+
+    /**
+     * @brief Estimates the weight of an ID that is held in the sketch rather than the table.
+     *
+     * @param id The location ID.
+     * @return The sketched part of the estimate, which is zero for exactly counted IDs.
+     */
+    [[nodiscard]] std::int64_t sketched_estimate(int id) const;
+
+    /**
+     * @brief Checks whether an ID is counted exactly.
+     *
+     * @param id The location ID.
+     * @return True if @c estimate is exact for @p id.
+     */
+    [[nodiscard]] bool is_exact(int id) const;
+
+    /**
+     * @brief Estimates the inner product of the sketched parts of two sketches.
+     *
+     * @param other A sketch created with the same configuration.
+     * @return An estimate that is never lower than the true inner product.
+     */
+    [[nodiscard]] double sketched_inner_product(const FrequencySketch& other) const;
+
+    /**
+     * @brief Get the total weight held in the sketch rather than the table.
+     *
+     * @return The total sketched weight.
+     */
+    [[nodiscard]] std::int64_t sketched_weight() const { return sketched_weight_; }
+
+    /**
+     * @brief Get the IDs that are tracked in the table of exact counters.
+     *
+     * @return The heavy hitters, in no particular order.
+     */
+    [[nodiscard]] const std::vector<HeavyHitter>& heavy_hitters() const { return heavy_hitters_; }
+
+    /**
+     * @brief Get the number of bytes used by the counters and the table.
+     *
+     * @return The approximate memory footprint, which does not depend on the stream length.
+     */
+    [[nodiscard]] std::size_t memory_usage() const;
+
+  private:
+    [[nodiscard]] std::size_t bucket(std::size_t row, int id) const;
+    void add_to_sketch(int id, std::int64_t weight);
+    void sift_down(std::size_t index);
+    void sift_up(std::size_t index);
+    void swap_heavy_hitters(std::size_t a, std::size_t b);
+};
+
+}  // namespace aoc24::day1
+
+#endif  // AOC24_CPP_SRC_DAY1_FREQUENCY_SKETCH_H_
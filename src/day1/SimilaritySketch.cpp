@@ -0,0 +1,83 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "SimilaritySketch.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+#include "day1.h"
+
+namespace aoc24::day1 {
+
+namespace {
+
+constexpr std::size_t kStreamBlockSize{std::size_t{1} << 20};
+
+[[nodiscard]] double exact_weight(const FrequencySketch& sketch) {
+    double weight{0.0};
+    for (const auto& heavy_hitter : sketch.heavy_hitters())
+        weight += static_cast<double>(heavy_hitter.count);
+    return weight;
+}
+
+}  // namespace
+
+SimilaritySketch::SimilaritySketch(const SketchConfig& config)
+    : left_{config}, right_{config}, epsilon_{config.epsilon}, delta_{config.delta} {}
+
+double SimilaritySketch::estimate() const {
+    // Split each list into its exactly counted part F and its sketched part C.
+    // The score is F_left * (F_right + C_right) + C_left * F_right + C_left * C_right.
+    double similarity_score{0.0};
+
+    for (const auto& heavy_hitter : left_.heavy_hitters())
+        similarity_score += static_cast<double>(heavy_hitter.count) *
+                            static_cast<double>(right_.estimate(heavy_hitter.id));
+
+    for (const auto& heavy_hitter : right_.heavy_hitters())
+        similarity_score += static_cast<double>(left_.sketched_estimate(heavy_hitter.id)) *
+                            static_cast<double>(heavy_hitter.count);
+
+    return similarity_score + left_.sketched_inner_product(right_);
+}
+
+double SimilaritySketch::error_bound() const {
+    // A Count-Min estimate overcounts by at most epsilon times the weight in the sketch it reads.
+    const auto left_sketched{static_cast<double>(left_.sketched_weight())};
+    const auto right_sketched{static_cast<double>(right_.sketched_weight())};
+    return epsilon_ * (exact_weight(left_) * right_sketched +
+                       left_sketched * exact_weight(right_) + left_sketched * right_sketched);
+}
+
+std::size_t SimilaritySketch::memory_usage() const {
+    return left_.memory_usage() + right_.memory_usage();
+}
+
+SimilaritySketch sketch_location_lists(const std::filesystem::path& file_path,
+                                       const SketchConfig& config) {
+    SimilaritySketch sketch{config};
+    read_location_lists_in_blocks(
+        file_path, kStreamBlockSize,
+        [&](const std::vector<int>& left_list, const std::vector<int>& right_list) {
+            for (const int left_val : left_list) sketch.add_left(left_val);
+            for (const int right_val : right_list) sketch.add_right(right_val);
+        });
+    return sketch;
+}
+
+}  // namespace aoc24::day1
@@ -0,0 +1,112 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_DAY1_SIMILARITY_SKETCH_H_
+#define AOC24_CPP_SRC_DAY1_SIMILARITY_SKETCH_H_
+
+#include <cstddef>
+#include <filesystem>
+
+#include "FrequencySketch.h"
+
+namespace aoc24::day1 {
+
+/**
+ * @brief Bounded-memory approximation of the similarity score for unbounded streams.
+ *
+ * The left list is summarised in a sketch weighted by the ID itself,
+ * and the right list in a sketch counting occurrences.
+ * The similarity score is the inner product of the two,
+ * which is computed exactly between heavy hitters
+ * and estimated with Count-Min for the rest.
+ * IDs may arrive from either list in any order.
+ * Location IDs are expected to be non-negative.
+ */
+class SimilaritySketch final {
+    FrequencySketch left_;
+    FrequencySketch right_;
+    double epsilon_{};
+    double delta_{};
+
+  public:
+    /**
+     * @brief Constructs an empty sketch.
+     *
+     * @param config The size and accuracy settings, used for both lists.
+     */
+    explicit SimilaritySketch(const SketchConfig& config);
+
+    /**
+     * @brief Adds an ID from the left list.
+     *
+     * @param id The location ID.
+     */
+    void add_left(const int id) { left_.add(id, id); }
+
+    /**
+     * @brief Adds an ID from the right list.
+     *
+     * @param id The location ID.
+     */
+    void add_right(const int id) { right_.add(id); }
+
+    /**
+     * @brief Estimates the similarity score of everything added so far.
+     *
+     * @return An estimate that is never lower than the true similarity score.
+     */
+    [[nodiscard]] double estimate() const;
+
+    /**
+     * @brief Get the maximum amount by which @c estimate may overestimate.
+     *
+     * The bound holds with probability @c confidence.
+     * It is zero when every ID of both lists was counted exactly.
+     *
+     * @return The additive error bound.
+     */
+    [[nodiscard]] double error_bound() const;
+
+    /**
+     * @brief Get the probability that the error stays within @c error_bound.
+     *
+     * @return The confidence, @c 1 - delta.
+     */
+    [[nodiscard]] double confidence() const { return 1.0 - delta_; }
+
+    /**
+     * @brief Get the number of bytes used by both sketches.
+     *
+     * @return The approximate memory footprint, which does not depend on the stream length.
+     */
+    [[nodiscard]] std::size_t memory_usage() const;
+};
+
+/**
+ * @brief Streams location data from a file into a similarity sketch.
+ *
+ * @param file_path The path to the file containing the location data.
+ * @param config The size and accuracy settings of the sketch.
+ * @return The sketch of the whole file.
+ * @throws FileReadException If the file cannot be opened or read.
+ * @throws ParseException If the file content cannot be parsed.
+ */
+[[nodiscard]] SimilaritySketch sketch_location_lists(const std::filesystem::path& file_path,
+                                                     const SketchConfig& config);
+
+}  // namespace aoc24::day1
+
+#endif  // AOC24_CPP_SRC_DAY1_SIMILARITY_SKETCH_H_
@@ -16,28 +16,40 @@
 
 #include "day1.h"
 
+#ifndef SPDLOG_ACTIVE_LEVEL
 #ifndef NDEBUG
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
 #else
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
 #endif
+#endif
 
+#include <fcntl.h>
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <cerrno>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <filesystem>
-#include <functional>
 #include <iterator>
 #include <lexy/action/parse.hpp>
 #include <lexy/callback.hpp>
+#include <lexy/callback/noop.hpp>
 #include <lexy/dsl.hpp>
 #include <lexy/input/string_input.hpp>
 #include <lexy_ext/report_error.hpp>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "../Expected.h"
+#include "../logging.h"
+#include "../multiversion.h"
 #include "../utils.h"
 
 namespace aoc24::day1 {
@@ -63,26 +75,94 @@ struct LocationListsParser {
         })};
 };
 
+struct FileCloser {
+    void operator()(std::FILE* file) const noexcept { std::fclose(file); }
+};
+
+AOC24_MULTIVERSION void absolute_differences(const int* left, const int* right, int* out,
+                                             const std::size_t count) {
+    for (std::size_t i{0}; i < count; ++i) out[i] = std::abs(left[i] - right[i]);
+}
+
+AOC24_MULTIVERSION std::int64_t sum_of_absolute_differences(const int* left, const int* right,
+                                                            const std::size_t count) {
+    std::int64_t sum{0};
+    for (std::size_t i{0}; i < count; ++i) {
+        const auto difference{std::int64_t{left[i]} - right[i]};
+        sum += difference < 0 ? -difference : difference;
+    }
+    return sum;
+}
+
 }  // namespace
 
-[[nodiscard]] std::pair<std::vector<int>, std::vector<int>> parse_location_lists(
+Expected<std::pair<std::vector<int>, std::vector<int>>> try_parse_location_lists(
     const std::string& file_contents, const std::filesystem::path& file_path) {
-    const auto input{lexy::string_input{file_contents}};
-    std::string error_message{};
+    // The grammar has no trailing separator, so leave out the final line terminator.
+    std::string_view contents{file_contents};
+    if (!contents.empty() && contents.back() == '\n') contents.remove_suffix(1);
+    if (contents.empty()) return std::make_pair(std::vector<int>{}, std::vector<int>{});
+
+    const auto input{lexy::string_input{contents}};
+    // Parse without building an error message first, since the input is normally well-formed.
+    auto clean_result{lexy::parse<LocationListsParser>(input, lexy::noop)};
+    if (clean_result.is_success()) return std::move(clean_result).value();
 
-    const auto result{lexy::parse<LocationListsParser>(
+    std::string error_message{};
+    auto result{lexy::parse<LocationListsParser>(
         input,
         lexy_ext::report_error.path(file_path.c_str()).to(std::back_inserter(error_message)))};
 
-    if (!result.has_value()) throw ParseException{error_message};
-    if (!error_message.empty()) SPDLOG_ERROR(error_message);
-    return result.value();
+    if (!result.has_value()) return AocError::parse(std::move(error_message));
+    AOC24_LOG_PARSE_ERROR(error_message);
+    return std::move(result).value();
+}
+
+Expected<std::pair<std::vector<int>, std::vector<int>>> try_read_location_lists(
+    const std::filesystem::path& file_path) {
+    auto file_contents{utils::try_read_file_contents(file_path)};
+    if (!file_contents) return file_contents.error();
+    return try_parse_location_lists(*file_contents, file_path);
 }
 
 std::pair<std::vector<int>, std::vector<int>> read_location_lists(
     const std::filesystem::path& file_path) {
-    const std::function file_parser{parse_location_lists};
-    return utils::read_input_file(file_path, file_parser);
+    return try_read_location_lists(file_path).value_or_throw();
+}
+
+void read_location_lists_in_blocks(
+    const std::filesystem::path& file_path, const std::size_t block_size,
+    const std::function<void(const std::vector<int>&, const std::vector<int>&)>& block_consumer) {
+    const std::unique_ptr<std::FILE, FileCloser> file{std::fopen(file_path.c_str(), "rb")};
+    if (file == nullptr) throw FileReadException{file_path, errno};
+    posix_fadvise(fileno(file.get()), 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    std::string block{};
+    std::string carry{};
+    for (bool at_end{false}; !at_end;) {
+        block.assign(carry);
+        const auto old_size{block.size()};
+        block.resize(old_size + block_size);
+        const auto read_size{std::fread(block.data() + old_size, 1, block_size, file.get())};
+        block.resize(old_size + read_size);
+
+        if (read_size < block_size) {
+            if (std::ferror(file.get()) != 0) throw FileReadException{file_path, errno};
+            at_end = true;
+            carry.clear();
+        } else {
+            // Keep the incomplete last line for the next block.
+            const auto last_newline{block.rfind('\n')};
+            const auto cut{last_newline == std::string::npos ? 0 : last_newline + 1};
+            carry.assign(block, cut);
+            block.resize(cut);
+        }
+
+        if (block.empty()) continue;
+        const auto [left_list, right_list]{
+            try_parse_location_lists(block, file_path).value_or_throw()};
+        block_consumer(left_list, right_list);
+    }
 }
 
 std::vector<int> calculate_distances(std::vector<int>&& left_list, std::vector<int>&& right_list) {
@@ -91,30 +171,24 @@ std::vector<int> calculate_distances(std::vector<int>&& left_list, std::vector<i
     std::sort(right_list.begin(), right_list.end());
 
     // Calculate the distances.
-    std::vector<int> distances{};
-    const std::size_t shortest_list_size{std::min(left_list.size(), right_list.size())};
-
-    for (std::size_t i{}; i < shortest_list_size; ++i)
-        distances.push_back(std::abs(left_list[i] - right_list[i]));
+    std::vector<int> distances(std::min(left_list.size(), right_list.size()));
+    absolute_differences(left_list.data(), right_list.data(), distances.data(), distances.size());
 
     // Return the distances.
     return distances;
 }
 
+std::int64_t sum_of_distances(const std::vector<int>& sorted_left_list,
+                              const std::vector<int>& sorted_right_list) {
+    const auto count{std::min(sorted_left_list.size(), sorted_right_list.size())};
+    return sum_of_absolute_differences(sorted_left_list.data(), sorted_right_list.data(), count);
+}
+
 int calculate_similarity_score(const std::vector<int>& left_list, std::vector<int>&& right_list) {
     // Sort the right list.
     std::sort(right_list.begin(), right_list.end());
 
-    // Calculate the similarity score.
-    std::ptrdiff_t similarity_score{0};
-
-    for (const int left_val : left_list) {
-        // Get the frequency of `left_val` in the right list.
-        const auto [l, r] = std::equal_range(right_list.begin(), right_list.end(), left_val);
-        const auto frequency{std::distance(l, r)};
-        // Update the similarity score.
-        similarity_score += left_val * frequency;
-    }
+    const auto similarity_score{calculate_similarity_score_sorted(left_list, right_list)};
 
     // Check if the value is in range of the return type.
     if (similarity_score < std::numeric_limits<int>::min() ||
@@ -126,4 +200,21 @@ int calculate_similarity_score(const std::vector<int>& left_list, std::vector<in
     return static_cast<int>(similarity_score);
 }
 
+std::int64_t calculate_similarity_score_sorted(const std::vector<int>& left_list,
+                                               const std::vector<int>& sorted_right_list) {
+    // Calculate the similarity score.
+    std::int64_t similarity_score{0};
+
+    for (const int left_val : left_list) {
+        // Get the frequency of `left_val` in the right list.
+        const auto [l, r] =
+            std::equal_range(sorted_right_list.begin(), sorted_right_list.end(), left_val);
+        const auto frequency{std::distance(l, r)};
+        // Update the similarity score.
+        similarity_score += std::int64_t{left_val} * frequency;
+    }
+
+    return similarity_score;
+}
+
 }  // namespace aoc24::day1
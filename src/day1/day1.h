@@ -17,10 +17,16 @@
 #ifndef AOC24_CPP_SRC_DAY1_DAY1_H_
 #define AOC24_CPP_SRC_DAY1_DAY1_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "../Expected.h"
 #include "../utils.h"
 
 namespace aoc24::day1 {
@@ -28,7 +34,8 @@ namespace aoc24::day1 {
 /**
  * @brief The path to the file containing the location lists.
  */
-const std::filesystem::path kLocationListsFilePath{utils::kInputDir / "day1.txt"};
+inline constexpr std::string_view kLocationListsFilePath{"input/day1.txt"};
+static_assert(kLocationListsFilePath.substr(0, utils::kInputDir.size()) == utils::kInputDir);
 
 /**
  * @brief Reads location data from a file and returns two separate lists of integers.
@@ -44,6 +51,45 @@ const std::filesystem::path kLocationListsFilePath{utils::kInputDir / "day1.txt"
 [[nodiscard]] std::pair<std::vector<int>, std::vector<int>> read_location_lists(
     const std::filesystem::path& file_path);
 
+/**
+ * @brief Parses location data without throwing on failure.
+ *
+ * Empty input is accepted and yields two empty lists, and a final line terminator is ignored.
+ *
+ * @param file_contents The location data, one pair of IDs per line.
+ * @param file_path The path the data was read from, used in error messages.
+ * @return The left and right location lists, or an @c ErrorCode::parse error.
+ */
+[[nodiscard]] Expected<std::pair<std::vector<int>, std::vector<int>>> try_parse_location_lists(
+    const std::string& file_contents, const std::filesystem::path& file_path);
+
+/**
+ * @brief Reads location data from a file without throwing on failure.
+ *
+ * @param file_path The path to the file containing the location data.
+ * @return The left and right location lists,
+ *         or an @c ErrorCode::file_read or @c ErrorCode::parse error.
+ * @see read_location_lists
+ */
+[[nodiscard]] Expected<std::pair<std::vector<int>, std::vector<int>>> try_read_location_lists(
+    const std::filesystem::path& file_path);
+
+/**
+ * @brief Reads location data in blocks, so that files of any size can be processed.
+ *
+ * Each block is cut at a line boundary and parsed on its own,
+ * so memory use is bounded by the block size rather than the file size.
+ *
+ * @param file_path The path to the file containing the location data.
+ * @param block_size The number of bytes to read at once.
+ * @param block_consumer Called with the left and right IDs of each block, in file order.
+ * @throws FileReadException If the file cannot be opened or read.
+ * @throws ParseException If a block cannot be parsed.
+ */
+void read_location_lists_in_blocks(
+    const std::filesystem::path& file_path, std::size_t block_size,
+    const std::function<void(const std::vector<int>&, const std::vector<int>&)>& block_consumer);
+
 /**
  * @brief Calculate the distances between pairs of location IDs.
  *
@@ -64,6 +110,18 @@ const std::filesystem::path kLocationListsFilePath{utils::kInputDir / "day1.txt"
 [[nodiscard]] std::vector<int> calculate_distances(std::vector<int>&& left_list,
                                                    std::vector<int>&& right_list);
 
+/**
+ * @brief Sums the distances between pairs of location IDs in already sorted lists.
+ *
+ * The sum is computed in 64 bits, so it does not overflow for large inputs.
+ *
+ * @param sorted_left_list The left list of location IDs, in ascending order.
+ * @param sorted_right_list The right list of location IDs, in ascending order.
+ * @return The total distance between the lists.
+ */
+[[nodiscard]] std::int64_t sum_of_distances(const std::vector<int>& sorted_left_list,
+                                            const std::vector<int>& sorted_right_list);
+
 /**
  * @brief Calculates the similarity score between the two location lists.
  *
@@ -83,6 +141,20 @@ const std::filesystem::path kLocationListsFilePath{utils::kInputDir / "day1.txt"
 [[nodiscard]] int calculate_similarity_score(const std::vector<int>& left_list,
                                              std::vector<int>&& right_list);
 
+/**
+ * @brief Calculates the similarity score of a left list and an already sorted right list.
+ *
+ * Unlike @c calculate_similarity_score, the score is returned in 64 bits,
+ * so it is not truncated for large inputs.
+ *
+ * @param left_list The left list of location IDs.
+ * @param sorted_right_list The right list of location IDs, in ascending order.
+ * @return The similarity score.
+ * @see calculate_similarity_score
+ */
+[[nodiscard]] std::int64_t calculate_similarity_score_sorted(
+    const std::vector<int>& left_list, const std::vector<int>& sorted_right_list);
+
 }  // namespace aoc24::day1
 
 #endif  // AOC24_CPP_SRC_DAY1_DAY1_H_
@@ -0,0 +1,204 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "external_sort.h"
+
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifndef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+#endif
+
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "../AocException.h"
+#include "day1.h"
+#include "sorted_runs.h"
+
+namespace aoc24::day1 {
+
+namespace {
+
+constexpr std::size_t kMinBlockSize{std::size_t{4} << 10};
+constexpr std::size_t kMaxBlockSize{std::size_t{4} << 20};
+constexpr std::size_t kMinRunCapacity{1024};
+constexpr std::size_t kMaxMergeBufferSize{std::size_t{1} << 20};
+
+/**
+ * @brief A uniquely named directory that is removed with its contents on destruction.
+ */
+class TempDirectory final {
+    std::filesystem::path path_{};
+
+  public:
+    explicit TempDirectory(const std::filesystem::path& parent) {
+        static std::atomic<unsigned> counter{0};
+        std::error_code error{};
+        const auto base{parent.empty() ? std::filesystem::temp_directory_path(error) : parent};
+        if (error) throw FileWriteException{"the temporary directory", error.value()};
+        path_ = base / ("aoc24-external-" + std::to_string(getpid()) + '-' +
+                        std::to_string(counter.fetch_add(1)));
+
+        std::filesystem::create_directories(path_, error);
+        if (error) throw FileWriteException{path_, error.value()};
+    }
+
+    TempDirectory(const TempDirectory& other) = delete;
+    TempDirectory(TempDirectory&& other) = delete;
+    TempDirectory& operator=(const TempDirectory& other) = delete;
+    TempDirectory& operator=(TempDirectory&& other) = delete;
+
+    ~TempDirectory() {
+        std::error_code error{};
+        std::filesystem::remove_all(path_, error);
+        if (error) SPDLOG_WARN("Failed to remove {}: {}", path_.string(), error.message());
+    }
+
+    [[nodiscard]] const std::filesystem::path& path() const { return path_; }
+};
+
+/**
+ * @brief Sorts the buffered IDs of one list and spills them to a new run file.
+ */
+class RunSpiller final {
+    const std::filesystem::path& directory_;
+    const char* name_{};
+    std::vector<std::filesystem::path> runs_{};
+
+  public:
+    RunSpiller(const std::filesystem::path& directory, const char* name)
+        : directory_{directory}, name_{name} {}
+
+    void spill(std::vector<int>& values) {
+        if (values.empty()) return;
+        std::sort(values.begin(), values.end());
+        runs_.push_back(directory_ / (std::string{name_} + '-' + std::to_string(runs_.size())));
+        write_sorted_run(runs_.back(), values);
+        values.clear();
+    }
+
+    /**
+     * @brief Merges runs in groups until at most @p fan_in are left.
+     */
+    void reduce(const std::size_t fan_in, const std::size_t buffer_size) {
+        for (std::size_t pass{0}; runs_.size() > fan_in; ++pass) {
+            std::vector<std::filesystem::path> merged_runs{};
+
+            for (std::size_t begin{0}; begin < runs_.size(); begin += fan_in) {
+                const auto end{std::min(begin + fan_in, runs_.size())};
+                const std::vector group(runs_.begin() + static_cast<std::ptrdiff_t>(begin),
+                                        runs_.begin() + static_cast<std::ptrdiff_t>(end));
+                merged_runs.push_back(directory_ / (std::string{name_} + "-pass" +
+                                                   std::to_string(pass) + '-' +
+                                                   std::to_string(merged_runs.size())));
+                merge_runs(group, merged_runs.back(), buffer_size);
+                for (const auto& run : group) {
+                    // Merged runs are only deleted early to save disk space;
+                    // the temporary directory removes any that are left.
+                    std::error_code error{};
+                    std::filesystem::remove(run, error);
+                    if (error)
+                        SPDLOG_WARN("Failed to remove {}: {}", run.string(), error.message());
+                }
+            }
+
+            runs_ = std::move(merged_runs);
+        }
+    }
+
+    [[nodiscard]] const std::vector<std::filesystem::path>& runs() const { return runs_; }
+};
+
+}  // namespace
+
+ExternalSortResult calculate_totals_external(const std::filesystem::path& file_path,
+                                             const ExternalSortConfig& config) {
+    // Split the budget between the input block, the parser output for one block
+    // (at most two IDs per four bytes of input) and the buffered IDs of both lists.
+    const auto block_size{std::clamp(config.memory_budget / 16, kMinBlockSize, kMaxBlockSize)};
+    const auto buffer_budget{config.memory_budget > 4 * block_size
+                                 ? config.memory_budget - 4 * block_size
+                                 : std::size_t{0}};
+    const auto run_capacity{std::max(kMinRunCapacity, buffer_budget / (2 * sizeof(int)))};
+    const auto fan_in{std::max<std::size_t>(2, config.max_merge_fan_in)};
+
+    const TempDirectory spill_dir{config.temp_dir};
+    RunSpiller left_spiller{spill_dir.path(), "left"};
+    RunSpiller right_spiller{spill_dir.path(), "right"};
+    std::vector<int> left_buffer{};
+    std::vector<int> right_buffer{};
+    left_buffer.reserve(run_capacity);
+    right_buffer.reserve(run_capacity);
+
+    // Fill a buffer exactly to its capacity before spilling it,
+    // so that it never reallocates beyond what the budget reserved.
+    const auto buffer_ids{[&](const std::vector<int>& ids, std::vector<int>& buffer,
+                              RunSpiller& spiller) {
+        for (auto next{ids.begin()}; next != ids.end();) {
+            const auto count{std::min(run_capacity - buffer.size(),
+                                      static_cast<std::size_t>(ids.end() - next))};
+            buffer.insert(buffer.end(), next, next + static_cast<std::ptrdiff_t>(count));
+            next += static_cast<std::ptrdiff_t>(count);
+            if (buffer.size() >= run_capacity) spiller.spill(buffer);
+        }
+    }};
+    const auto buffer_block{
+        [&](const std::vector<int>& left_list, const std::vector<int>& right_list) {
+            buffer_ids(left_list, left_buffer, left_spiller);
+            buffer_ids(right_list, right_buffer, right_spiller);
+        }};
+    read_location_lists_in_blocks(file_path, block_size, buffer_block);
+
+    left_spiller.spill(left_buffer);
+    right_spiller.spill(right_buffer);
+    // Give the memory back before merging.
+    left_buffer.shrink_to_fit();
+    right_buffer.shrink_to_fit();
+
+    const auto merge_buffer_size{[&](const std::size_t reader_count) {
+        const auto per_reader{config.memory_budget / (std::max<std::size_t>(1, reader_count) *
+                                                      sizeof(int))};
+        return std::clamp(per_reader, kMinRunCapacity, kMaxMergeBufferSize);
+    }};
+
+    ExternalSortResult result{};
+    result.run_count = std::max(left_spiller.runs().size(), right_spiller.runs().size());
+
+    left_spiller.reduce(fan_in, merge_buffer_size(fan_in + 1));
+    right_spiller.reduce(fan_in, merge_buffer_size(fan_in + 1));
+
+    const auto& left_runs{left_spiller.runs()};
+    const auto& right_runs{right_spiller.runs()};
+    const auto buffer_size{merge_buffer_size(left_runs.size() + right_runs.size())};
+    SPDLOG_DEBUG("Merging {} left and {} right runs with {} IDs per buffer.", left_runs.size(),
+                 right_runs.size(), buffer_size);
+
+    result.total_distance = merge_total_distance(left_runs, right_runs, buffer_size);
+    result.similarity_score = merge_similarity_score(left_runs, right_runs, buffer_size);
+    return result;
+}
+
+}  // namespace aoc24::day1
@@ -0,0 +1,83 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_DAY1_EXTERNAL_SORT_H_
+#define AOC24_CPP_SRC_DAY1_EXTERNAL_SORT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace aoc24::day1 {
+
+/**
+ * @brief The settings for processing location lists that do not fit in memory.
+ */
+struct ExternalSortConfig {
+    /**
+     * @brief The approximate number of bytes of memory to use for buffers.
+     */
+    std::size_t memory_budget{std::size_t{64} << 20};
+
+    /**
+     * @brief The directory to spill sorted runs to, or empty for the system temporary directory.
+     */
+    std::filesystem::path temp_dir{};
+
+    /**
+     * @brief The maximum number of runs merged at once.
+     *
+     * When more runs are spilled, they are first merged into fewer, longer runs,
+     * which keeps the number of open files and buffers bounded.
+     */
+    std::size_t max_merge_fan_in{128};
+};
+
+/**
+ * @brief The answers computed by the external-memory path.
+ */
+struct ExternalSortResult {
+    /** The sum of the distances between the paired location IDs. */
+    std::int64_t total_distance{};
+    /** The similarity score of the two location lists. */
+    std::int64_t similarity_score{};
+    /** The number of sorted runs that were spilled per list. */
+    std::size_t run_count{};
+};
+
+/**
+ * @brief Computes the total distance and similarity score of location lists of any size.
+ *
+ * The input is read and parsed in blocks.
+ * Whenever the buffered IDs reach the memory budget, they are sorted
+ * with the in-memory engine and spilled to a run file.
+ * The runs of both lists are then merged in lockstep to compute the answers in a streaming fashion.
+ * The results are equal to those of @c calculate_distances and @c calculate_similarity_score,
+ * except that they are not limited to the range of @c int.
+ *
+ * @param file_path The path to the file containing the location data.
+ * @param config The memory and spill settings.
+ * @return The total distance and similarity score.
+ * @throws FileReadException If the input or a run file cannot be read.
+ * @throws FileWriteException If a run file cannot be written.
+ * @throws ParseException If the input cannot be parsed.
+ */
+[[nodiscard]] ExternalSortResult calculate_totals_external(const std::filesystem::path& file_path,
+                                                           const ExternalSortConfig& config);
+
+}  // namespace aoc24::day1
+
+#endif  // AOC24_CPP_SRC_DAY1_EXTERNAL_SORT_H_
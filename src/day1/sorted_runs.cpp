@@ -0,0 +1,186 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "sorted_runs.h"
+
+#include <fcntl.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../AocException.h"
+
+namespace aoc24::day1 {
+
+namespace {
+
+struct FileCloser {
+    void operator()(std::FILE* file) const noexcept { std::fclose(file); }
+};
+
+}  // namespace
+
+void write_sorted_run(const std::filesystem::path& file_path,
+                      const std::vector<int>& sorted_values) {
+    const std::unique_ptr<std::FILE, FileCloser> file{std::fopen(file_path.c_str(), "wb")};
+    if (file == nullptr) throw FileWriteException{file_path, errno};
+
+    const auto written{
+        std::fwrite(sorted_values.data(), sizeof(int), sorted_values.size(), file.get())};
+    if (written != sorted_values.size()) throw FileWriteException{file_path, errno};
+    if (std::fflush(file.get()) != 0) throw FileWriteException{file_path, errno};
+}
+
+RunReader::RunReader(const std::filesystem::path& file_path, const std::size_t buffer_size)
+    : file_{std::fopen(file_path.c_str(), "rb")},
+      file_path_{file_path},
+      buffer_(buffer_size == 0 ? 1 : buffer_size) {
+    if (file_ == nullptr) throw FileReadException{file_path, errno};
+    // The reader is already buffered, so don't let stdio copy everything twice.
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+    // Runs are always read front to back, so let the kernel read ahead aggressively.
+    posix_fadvise(fileno(file_), 0, 0, POSIX_FADV_SEQUENTIAL);
+}
+
+RunReader::RunReader(RunReader&& other) noexcept
+    : file_{std::exchange(other.file_, nullptr)},
+      file_path_{std::move(other.file_path_)},
+      buffer_{std::move(other.buffer_)},
+      position_{other.position_},
+      size_{other.size_} {}
+
+RunReader::~RunReader() {
+    if (file_ != nullptr) std::fclose(file_);
+}
+
+bool RunReader::next(int& value) {
+    if (position_ == size_) {
+        size_ = std::fread(buffer_.data(), sizeof(int), buffer_.size(), file_);
+        position_ = 0;
+        if (size_ == 0) {
+            if (std::ferror(file_) != 0) throw FileReadException{file_path_, errno};
+            return false;
+        }
+    }
+
+    value = buffer_[position_++];
+    return true;
+}
+
+RunMerger::RunMerger(const std::vector<std::filesystem::path>& run_paths,
+                     const std::size_t buffer_size) {
+    readers_.reserve(run_paths.size());
+    for (const auto& run_path : run_paths) readers_.emplace_back(run_path, buffer_size);
+
+    for (std::size_t i{0}; i < readers_.size(); ++i) {
+        int value{};
+        if (readers_[i].next(value)) heads_.emplace(value, i);
+    }
+}
+
+bool RunMerger::next(int& value) {
+    if (heads_.empty()) return false;
+
+    const auto [head_value, reader_index]{heads_.top()};
+    heads_.pop();
+    value = head_value;
+
+    int next_value{};
+    if (readers_[reader_index].next(next_value)) heads_.emplace(next_value, reader_index);
+    return true;
+}
+
+std::int64_t merge_total_distance(const std::vector<std::filesystem::path>& left_runs,
+                                  const std::vector<std::filesystem::path>& right_runs,
+                                  const std::size_t buffer_size) {
+    RunMerger left{left_runs, buffer_size};
+    RunMerger right{right_runs, buffer_size};
+    std::int64_t total_distance{0};
+
+    for (int left_val{}, right_val{}; left.next(left_val) && right.next(right_val);) {
+        const auto distance{std::int64_t{left_val} - std::int64_t{right_val}};
+        total_distance += distance < 0 ? -distance : distance;
+    }
+
+    return total_distance;
+}
+
+std::int64_t merge_similarity_score(const std::vector<std::filesystem::path>& left_runs,
+                                    const std::vector<std::filesystem::path>& right_runs,
+                                    const std::size_t buffer_size) {
+    RunMerger left{left_runs, buffer_size};
+    RunMerger right{right_runs, buffer_size};
+    std::int64_t similarity_score{0};
+
+    int left_val{};
+    int right_val{};
+    bool has_left{left.next(left_val)};
+    bool has_right{right.next(right_val)};
+
+    while (has_left && has_right) {
+        if (left_val < right_val) {
+            has_left = left.next(left_val);
+        } else if (right_val < left_val) {
+            has_right = right.next(right_val);
+        } else {
+            // Count the equal IDs on both sides.
+            const int value{left_val};
+            std::int64_t left_count{0};
+            std::int64_t right_count{0};
+            while (has_left && left_val == value) {
+                ++left_count;
+                has_left = left.next(left_val);
+            }
+            while (has_right && right_val == value) {
+                ++right_count;
+                has_right = right.next(right_val);
+            }
+            similarity_score += value * left_count * right_count;
+        }
+    }
+
+    return similarity_score;
+}
+
+void merge_runs(const std::vector<std::filesystem::path>& run_paths,
+                const std::filesystem::path& output_path, const std::size_t buffer_size) {
+    RunMerger merger{run_paths, buffer_size};
+    const std::unique_ptr<std::FILE, FileCloser> file{std::fopen(output_path.c_str(), "wb")};
+    if (file == nullptr) throw FileWriteException{output_path, errno};
+
+    std::vector<int> buffer{};
+    buffer.reserve(buffer_size == 0 ? 1 : buffer_size);
+    const auto flush_buffer{[&] {
+        if (std::fwrite(buffer.data(), sizeof(int), buffer.size(), file.get()) != buffer.size())
+            throw FileWriteException{output_path, errno};
+        buffer.clear();
+    }};
+
+    for (int value{}; merger.next(value);) {
+        buffer.push_back(value);
+        if (buffer.size() == buffer.capacity()) flush_buffer();
+    }
+
+    flush_buffer();
+    if (std::fflush(file.get()) != 0) throw FileWriteException{output_path, errno};
+}
+
+}  // namespace aoc24::day1
@@ -0,0 +1,167 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_DAY1_SORTED_RUNS_H_
+#define AOC24_CPP_SRC_DAY1_SORTED_RUNS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace aoc24::day1 {
+
+/**
+ * @brief Writes sorted location IDs to a run file.
+ *
+ * Run files contain the IDs as raw native-endian integers,
+ * so they are only meant to be read back on the same machine.
+ *
+ * @param file_path The path of the run file to create.
+ * @param sorted_values The IDs to write, in ascending order.
+ * @throws FileWriteException If the file cannot be created or written.
+ */
+void write_sorted_run(const std::filesystem::path& file_path, const std::vector<int>& sorted_values);
+
+/**
+ * @brief Sequentially reads a run file through a large buffer.
+ */
+class RunReader final {
+    std::FILE* file_{};
+    std::filesystem::path file_path_{};
+    std::vector<int> buffer_{};
+    std::size_t position_{};
+    std::size_t size_{};
+
+  public:
+    /**
+     * @brief The default number of IDs read from the file at once.
+     */
+    static constexpr std::size_t kDefaultBufferSize{std::size_t{1} << 16};
+
+    /**
+     * @brief Opens a run file for reading.
+     *
+     * @param file_path The path of the run file.
+     * @param buffer_size The number of IDs read from the file at once.
+     * @throws FileReadException If the file cannot be opened.
+     */
+    explicit RunReader(const std::filesystem::path& file_path,
+                       std::size_t buffer_size = kDefaultBufferSize);
+
+    RunReader(const RunReader& other) = delete;
+    RunReader(RunReader&& other) noexcept;
+    RunReader& operator=(const RunReader& other) = delete;
+    RunReader& operator=(RunReader&& other) = delete;
+
+    /**
+     * @brief Closes the file.
+     */
+    ~RunReader();
+
+    /**
+     * @brief Reads the next ID.
+     *
+     * @param value Set to the next ID if there is one.
+     * @return True if an ID was read, false at the end of the run.
+     * @throws FileReadException If reading fails.
+     */
+    [[nodiscard]] bool next(int& value);
+};
+
+/**
+ * @brief Merges any number of run files into a single ascending sequence.
+ */
+class RunMerger final {
+    using Entry = std::pair<int, std::size_t>;
+
+    std::vector<RunReader> readers_{};
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heads_{};
+
+  public:
+    /**
+     * @brief Opens the run files to merge.
+     *
+     * @param run_paths The paths of the run files.
+     * @param buffer_size The number of IDs each reader reads from its file at once.
+     * @throws FileReadException If a file cannot be opened or read.
+     */
+    explicit RunMerger(const std::vector<std::filesystem::path>& run_paths,
+                       std::size_t buffer_size = RunReader::kDefaultBufferSize);
+
+    /**
+     * @brief Reads the next smallest ID across all runs.
+     *
+     * @param value Set to the next ID if there is one.
+     * @return True if an ID was read, false when all runs are exhausted.
+     * @throws FileReadException If reading fails.
+     */
+    [[nodiscard]] bool next(int& value);
+};
+
+/**
+ * @brief Computes the total distance between two location lists stored as sorted runs.
+ *
+ * Both lists are merged in lockstep, so only one buffer per run is kept in memory.
+ * As with @c calculate_distances, surplus IDs in the longer list are ignored.
+ *
+ * @param left_runs The run files of the left list.
+ * @param right_runs The run files of the right list.
+ * @param buffer_size The number of IDs each reader reads from its file at once.
+ * @return The sum of the distances between the pairs of IDs.
+ * @throws FileReadException If a file cannot be opened or read.
+ */
+[[nodiscard]] std::int64_t merge_total_distance(
+    const std::vector<std::filesystem::path>& left_runs,
+    const std::vector<std::filesystem::path>& right_runs,
+    std::size_t buffer_size = RunReader::kDefaultBufferSize);
+
+/**
+ * @brief Computes the similarity score of two location lists stored as sorted runs.
+ *
+ * Both lists are merged and joined on equal IDs in a single pass.
+ *
+ * @param left_runs The run files of the left list.
+ * @param right_runs The run files of the right list.
+ * @param buffer_size The number of IDs each reader reads from its file at once.
+ * @return The similarity score, as defined by @c calculate_similarity_score.
+ * @throws FileReadException If a file cannot be opened or read.
+ */
+[[nodiscard]] std::int64_t merge_similarity_score(
+    const std::vector<std::filesystem::path>& left_runs,
+    const std::vector<std::filesystem::path>& right_runs,
+    std::size_t buffer_size = RunReader::kDefaultBufferSize);
+
+/**
+ * @brief Merges several run files into a single run file.
+ *
+ * @param run_paths The run files to merge.
+ * @param output_path The path of the merged run file to create.
+ * @param buffer_size The number of IDs buffered per input run and for the output.
+ * @throws FileReadException If an input file cannot be opened or read.
+ * @throws FileWriteException If the output file cannot be written.
+ */
+void merge_runs(const std::vector<std::filesystem::path>& run_paths,
+                const std::filesystem::path& output_path,
+                std::size_t buffer_size = RunReader::kDefaultBufferSize);
+
+}  // namespace aoc24::day1
+
+#endif  // AOC24_CPP_SRC_DAY1_SORTED_RUNS_H_
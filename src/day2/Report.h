@@ -17,17 +17,19 @@
 #ifndef AOC24_CPP_SRC_DAY2_REPORT_H_
 #define AOC24_CPP_SRC_DAY2_REPORT_H_
 
+#ifndef SPDLOG_ACTIVE_LEVEL
 #ifndef NDEBUG
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
 #else
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
 #endif
+#endif
 
 #include <spdlog/formatter.h>
 
 #include <cstddef>
 #include <initializer_list>
-#include <string>
+#include <iterator>
 #include <vector>
 
 namespace aoc24::day2 {
@@ -142,7 +144,7 @@ using namespace aoc24::day2;
  * @brief Specialization of the @c formatter template for formatting @c Report objects.
  */
 template <>
-struct formatter<Report> : formatter<std::string> {
+struct formatter<Report> : formatter<string_view> {
     /**
      * @brief Formats a @c Report object into a string for output.
      *
@@ -151,16 +153,18 @@ struct formatter<Report> : formatter<std::string> {
      * @return An iterator pointing to the end of the formatted content in the context.
      */
     format_context::iterator format(const Report& report, format_context& ctx) const {
-        const auto& levels{report.levels()};
-        std::string levels_str{'['};
-
-        for (std::size_t i{0}; i < levels.size() - 1; ++i) {
-            levels_str += std::to_string(levels[i]) + ", ";
+        memory_buffer buffer{};
+        auto out{std::back_inserter(buffer)};
+        out = format_to(out, "Report {{ levels: [");
+
+        const char* separator{""};
+        for (const auto level : report.levels()) {
+            out = format_to(out, "{}{}", separator, level);
+            separator = ", ";
         }
 
-        levels_str += std::to_string(levels.back()) + ']';
-        const std::string output{"Report { levels: " + levels_str + " }"};
-        return formatter<std::string>::format(output, ctx);
+        format_to(out, "] }}");
+        return formatter<string_view>::format(string_view{buffer.data(), buffer.size()}, ctx);
     }
 };
 
@@ -0,0 +1,168 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "ReportTable.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "../AocException.h"
+
+namespace aoc24::day2 {
+
+namespace {
+
+[[nodiscard]] constexpr bool is_safe_step(const std::int64_t step, const int direction) {
+    const auto rise{step * direction};
+    return rise >= 1 && rise <= 3;
+}
+
+[[nodiscard]] constexpr int direction_of(const std::int64_t step) {
+    return (step > 0) - (step < 0);
+}
+
+[[nodiscard]] constexpr std::int8_t saturate(const std::int64_t step) {
+    return static_cast<std::int8_t>(std::clamp<std::int64_t>(
+        step, std::numeric_limits<std::int8_t>::min(), std::numeric_limits<std::int8_t>::max()));
+}
+
+void set_bit(std::vector<std::uint64_t>& bits, const std::size_t index) {
+    bits[index / 64] |= std::uint64_t{1} << (index % 64);
+}
+
+[[nodiscard]] std::size_t count_bits(const std::vector<std::uint64_t>& bits) {
+    std::size_t count{0};
+    for (const auto word : bits) count += static_cast<std::size_t>(__builtin_popcountll(word));
+    return count;
+}
+
+}  // namespace
+
+ReportTable::ReportTable(const std::vector<Report>& reports) {
+    std::size_t level_count{0};
+    for (const auto& report : reports) level_count += report.levels().size();
+    levels_.reserve(level_count);
+    steps_.reserve(level_count);
+    level_offsets_.reserve(reports.size() + 1);
+    summaries_.reserve(reports.size());
+    removals_.reserve(reports.size());
+
+    for (const auto& report : reports) add(report.levels());
+}
+
+void ReportTable::add(const std::vector<Report::Level>& levels) {
+    const auto level_count{levels.size()};
+    if (level_count > std::numeric_limits<std::uint32_t>::max())
+        throw OverflowException{"A report has " + std::to_string(level_count) +
+                                " levels, more than a report table can hold"};
+
+    // Steps are stored at the index of the level they lead to, so the first one is unused.
+    if (level_count > 0) steps_.push_back(0);
+    for (std::size_t i{1}; i < level_count; ++i)
+        steps_.push_back(saturate(std::int64_t{levels[i]} - levels[i - 1]));
+    levels_.insert(levels_.end(), levels.begin(), levels.end());
+    level_offsets_.push_back(levels_.size());
+
+    ReportSummary summary{static_cast<std::uint32_t>(level_count), 0, 0};
+    if (level_count >= 2) {
+        const auto* steps{steps_.data() + level_offsets_[size()]};
+        summary.direction = static_cast<std::int8_t>(direction_of(steps[1]));
+        for (std::size_t i{1}; i < level_count; ++i) {
+            if (is_safe_step(steps[i], summary.direction)) continue;
+            if (summary.violation_count++ == 0)
+                summary.first_violation = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    const auto report_index{size()};
+    summaries_.push_back(summary);
+    removals_.push_back(evaluate_dampener(report_index));
+
+    if (report_index % 64 == 0) {
+        safe_bits_.push_back(0);
+        dampened_safe_bits_.push_back(0);
+    }
+    if (removals_.back() == DampenerRemoval::not_needed) set_bit(safe_bits_, report_index);
+    if (removals_.back() != DampenerRemoval::failed) set_bit(dampened_safe_bits_, report_index);
+}
+
+bool ReportTable::is_safe_without(const std::size_t report_index,
+                                  const std::size_t removed) const {
+    const auto offset{level_offsets_[report_index]};
+    const auto level_count{level_offsets_[report_index + 1] - offset};
+    const auto* levels{levels_.data() + offset};
+    const auto& summary{summaries_[report_index]};
+
+    if (removed >= 2) {
+        // The first step and thereby the direction stay the same. Removing the level merges
+        // the steps before and after it, so every other step has to be safe already.
+        const auto* steps{steps_.data() + offset};
+        const bool has_next{removed + 1 < level_count};
+        std::uint32_t removed_violations{!is_safe_step(steps[removed], summary.direction)};
+        if (has_next) removed_violations += !is_safe_step(steps[removed + 1], summary.direction);
+        if (summary.violation_count != removed_violations) return false;
+        return !has_next ||
+               is_safe_step(std::int64_t{levels[removed + 1]} - levels[removed - 1],
+                            summary.direction);
+    }
+
+    // Removing one of the first two levels may change the direction, so rescan the report.
+    const auto remaining_count{level_count - 1};
+    if (remaining_count < 2) return true;
+    const auto level_at{[&](const std::size_t i) -> std::int64_t {
+        return levels[i < removed ? i : i + 1];
+    }};
+    const auto direction{direction_of(level_at(1) - level_at(0))};
+    for (std::size_t i{1}; i < remaining_count; ++i)
+        if (!is_safe_step(level_at(i) - level_at(i - 1), direction)) return false;
+    return true;
+}
+
+DampenerRemoval ReportTable::evaluate_dampener(const std::size_t report_index) const {
+    const auto& summary{summaries_[report_index]};
+    if (summary.violation_count == 0) return DampenerRemoval::not_needed;
+
+    // The same removals, in the same order, as evaluate_problem_dampener.
+    const std::size_t problem_index{summary.first_violation};
+    if (is_safe_without(report_index, problem_index - 1)) return DampenerRemoval::previous;
+    if (is_safe_without(report_index, problem_index)) return DampenerRemoval::problem;
+    if (problem_index == 2 && is_safe_without(report_index, 0)) return DampenerRemoval::first;
+    return DampenerRemoval::failed;
+}
+
+Report ReportTable::report(const std::size_t report_index) const {
+    const auto begin{static_cast<std::ptrdiff_t>(level_offsets_[report_index])};
+    const auto end{static_cast<std::ptrdiff_t>(level_offsets_[report_index + 1])};
+    return Report{std::vector<Report::Level>(levels_.begin() + begin, levels_.begin() + end)};
+}
+
+std::size_t ReportTable::count_safe() const { return count_bits(safe_bits_); }
+
+std::size_t ReportTable::count_safe_with_problem_dampener() const {
+    return count_bits(dampened_safe_bits_);
+}
+
+std::size_t ReportTable::memory_usage() const {
+    return levels_.capacity() * sizeof(Report::Level) + steps_.capacity() * sizeof(std::int8_t) +
+           level_offsets_.capacity() * sizeof(std::size_t) +
+           summaries_.capacity() * sizeof(ReportSummary) +
+           removals_.capacity() * sizeof(DampenerRemoval) +
+           (safe_bits_.capacity() + dampened_safe_bits_.capacity()) * sizeof(std::uint64_t);
+}
+
+}  // namespace aoc24::day2
@@ -0,0 +1,141 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_DAY2_REPORT_TABLE_H_
+#define AOC24_CPP_SRC_DAY2_REPORT_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Report.h"
+#include "day2.h"
+
+namespace aoc24::day2 {
+
+/**
+ * @brief The safety facts of one report, computed once when it is added to a @c ReportTable.
+ */
+struct ReportSummary {
+    /** The index of the first level that violates the safety rules, or the number of levels. */
+    std::uint32_t first_violation{};
+    /** The number of steps between adjacent levels that violate the safety rules. */
+    std::uint32_t violation_count{};
+    /** The direction set by the first step: 1 if increasing, -1 if decreasing, 0 if flat. */
+    std::int8_t direction{};
+};
+
+/**
+ * @brief Reports stored column by column, with their safety precomputed.
+ *
+ * The levels of all reports share one array, next to which the step between each pair of
+ * adjacent levels is stored as a saturated @c int8_t. A saturated step is out of the safe range
+ * either way, so no information needed for the safety rules is lost.
+ *
+ * Each report is evaluated once when it is added. Safety without and with the problem dampener
+ * is kept in two bitmaps, so counting safe reports is a popcount, and the summaries and
+ * dampener outcomes can be queried again at no cost.
+ *
+ * The problem dampener only looks at the steps around the first violation:
+ * removing a level merges the two steps next to it, and when the removal keeps the direction,
+ * every other step is known to be safe from the violation count.
+ * Only removals that change the direction, those of the first two levels, rescan the report.
+ * The outcomes are identical to @c evaluate_problem_dampener.
+ */
+class ReportTable final {
+    std::vector<Report::Level> levels_{};
+    std::vector<std::int8_t> steps_{};
+    std::vector<std::size_t> level_offsets_{0};
+    std::vector<ReportSummary> summaries_{};
+    std::vector<DampenerRemoval> removals_{};
+    std::vector<std::uint64_t> safe_bits_{};
+    std::vector<std::uint64_t> dampened_safe_bits_{};
+
+    [[nodiscard]] bool is_safe_without(std::size_t report_index, std::size_t removed) const;
+    [[nodiscard]] DampenerRemoval evaluate_dampener(std::size_t report_index) const;
+
+  public:
+    /**
+     * @brief Constructs an empty table.
+     */
+    ReportTable() = default;
+
+    /**
+     * @brief Constructs a table holding the given reports.
+     *
+     * @param reports The reports to add, in order.
+     * @throw OverflowException If a report has more than @c UINT32_MAX levels.
+     */
+    explicit ReportTable(const std::vector<Report>& reports);
+
+    /**
+     * @brief Adds a report and evaluates it.
+     *
+     * @param levels The levels of the report.
+     * @throw OverflowException If the report has more than @c UINT32_MAX levels.
+     */
+    void add(const std::vector<Report::Level>& levels);
+
+    /**
+     * @brief The number of reports.
+     */
+    [[nodiscard]] std::size_t size() const { return summaries_.size(); }
+
+    /**
+     * @brief The levels of a report.
+     *
+     * @param report_index The index of the report, which must be less than @c size().
+     * @return A copy of the report.
+     */
+    [[nodiscard]] Report report(std::size_t report_index) const;
+
+    /**
+     * @brief The safety facts of a report.
+     *
+     * @param report_index The index of the report, which must be less than @c size().
+     */
+    [[nodiscard]] const ReportSummary& summary(const std::size_t report_index) const {
+        return summaries_[report_index];
+    }
+
+    /**
+     * @brief The problem dampener outcome of a report.
+     *
+     * @param report_index The index of the report, which must be less than @c size().
+     */
+    [[nodiscard]] DampenerRemoval removal(const std::size_t report_index) const {
+        return removals_[report_index];
+    }
+
+    /**
+     * @brief Counts the reports that are safe on their own.
+     */
+    [[nodiscard]] std::size_t count_safe() const;
+
+    /**
+     * @brief Counts the reports that are safe when using the problem dampener.
+     */
+    [[nodiscard]] std::size_t count_safe_with_problem_dampener() const;
+
+    /**
+     * @brief The number of bytes used by the table's arrays.
+     */
+    [[nodiscard]] std::size_t memory_usage() const;
+};
+
+}  // namespace aoc24::day2
+
+#endif  // AOC24_CPP_SRC_DAY2_REPORT_TABLE_H_
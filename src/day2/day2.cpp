@@ -16,26 +16,38 @@
 
 #include "day2.h"
 
+#ifndef SPDLOG_ACTIVE_LEVEL
 #ifndef NDEBUG
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
 #else
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
 #endif
+#endif
 
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <iterator>
 #include <lexy/action/parse.hpp>
+#include <lexy/callback/noop.hpp>
 #include <lexy/dsl.hpp>
 #include <lexy/input/string_input.hpp>
 #include <lexy_ext/report_error.hpp>
 #include <limits>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "../AocException.h"
+#include "../Expected.h"
+#include "../logging.h"
 #include "Report.h"
 
 namespace aoc24::day2 {
@@ -60,39 +72,145 @@ struct ReportParser {
     static constexpr auto value{lexy::construct<Report>};
 };
 
-}  // namespace
-
-[[nodiscard]] Report parse_reactor_data_line(const std::string& line) {
+[[nodiscard]] std::string describe_parse_errors(const std::string_view line) {
     const auto input{lexy::string_input{line}};
     std::string error_message{};
-
-    const auto result{lexy::parse<ReportParser>(
+    [[maybe_unused]] const auto result{lexy::parse<ReportParser>(
         input, lexy_ext::report_error.to(std::back_inserter(error_message)))};
+    return error_message;
+}
+
+/**
+ * @brief The reports and errors of a single chunk of input.
+ */
+struct ChunkResult {
+    std::vector<Report> reports{};
+    std::vector<LineError> errors{};
+    std::size_t line_count{};
+};
+
+void parse_chunk(const utils::TextChunk& chunk, ChunkResult& chunk_result) {
+    chunk_result.line_count =
+        utils::for_each_line(chunk.text, [&](const std::string_view line, const std::size_t offset) {
+            const auto input{lexy::string_input{line}};
+            auto result{lexy::parse<ReportParser>(input, lexy::noop)};
+
+            if (result.is_success()) {
+                chunk_result.reports.push_back(std::move(result).value());
+                return;
+            }
+
+            // Line numbers are relative to the chunk until the results are merged.
+            chunk_result.errors.push_back({chunk_result.reports.size() +
+                                               chunk_result.errors.size() + 1,
+                                           chunk.byte_offset + offset, describe_parse_errors(line)});
+        });
+}
+
+}  // namespace
+
+Expected<Report> try_parse_reactor_data_line(const std::string_view line) {
+    const auto input{lexy::string_input{line}};
+    // Parse without building an error message first, since almost every line is well-formed.
+    auto result{lexy::parse<ReportParser>(input, lexy::noop)};
+    if (result.is_success()) return std::move(result).value();
 
-    if (!result.has_value()) throw ParseException{error_message};
+    auto error_message{describe_parse_errors(line)};
+    if (!result.has_value()) return AocError::parse(std::move(error_message));
     // Report any non-fatal errors.
-    if (!error_message.empty()) SPDLOG_ERROR(error_message);
-    return result.value();
+    AOC24_LOG_PARSE_ERROR(error_message);
+    return std::move(result).value();
+}
+
+Report parse_reactor_data_line(const std::string& line) {
+    return try_parse_reactor_data_line(line).value_or_throw();
+}
+
+Expected<std::vector<Report>> try_read_reactor_data(const std::filesystem::path& file_path) {
+    const auto file_contents{utils::try_read_file_contents(file_path)};
+    if (!file_contents) return file_contents.error();
+    return try_parse_reactor_data(*file_contents);
+}
+
+Expected<std::vector<Report>> try_parse_reactor_data(const std::string_view contents) {
+    std::vector<Report> reports{};
+    std::optional<AocError> error{};
+    utils::for_each_line(contents, [&](const std::string_view line, std::size_t) {
+        if (error) return;
+        auto report{try_parse_reactor_data_line(line)};
+        if (report)
+            reports.push_back(std::move(*report));
+        else
+            error = report.error();
+    });
+
+    if (error) return *std::move(error);
+    return reports;
 }
 
 std::vector<Report> read_reactor_data(const std::filesystem::path& file_path) {
-    const std::function line_parser{parse_reactor_data_line};
-    return utils::read_input_lines(file_path, line_parser);
+    return try_read_reactor_data(file_path).value_or_throw();
+}
+
+TolerantParseResult parse_reactor_data_tolerant(const std::string_view contents,
+                                                const ParseRecoveryConfig& config) {
+    const auto thread_count{config.thread_count != 0
+                                ? config.thread_count
+                                : std::max(1U, std::thread::hardware_concurrency())};
+    const auto chunks{utils::split_at_line_boundaries(contents, thread_count, config.min_chunk_size)};
+    std::vector<ChunkResult> chunk_results(chunks.size());
+
+    // Parse the first chunk on this thread and the others on worker threads.
+    std::vector<std::thread> workers{};
+    workers.reserve(chunks.size());
+    for (std::size_t i{1}; i < chunks.size(); ++i)
+        workers.emplace_back(parse_chunk, std::cref(chunks[i]), std::ref(chunk_results[i]));
+    if (!chunks.empty()) parse_chunk(chunks.front(), chunk_results.front());
+    for (auto& worker : workers) worker.join();
+
+    // Merge the per-chunk buffers in input order.
+    TolerantParseResult result{};
+    std::size_t report_count{0};
+    std::size_t error_count{0};
+    for (const auto& chunk_result : chunk_results) {
+        report_count += chunk_result.reports.size();
+        error_count += chunk_result.errors.size();
+    }
+    result.reports.reserve(report_count);
+    result.errors.reserve(error_count);
+
+    std::size_t line_offset{0};
+    for (auto& chunk_result : chunk_results) {
+        std::move(chunk_result.reports.begin(), chunk_result.reports.end(),
+                  std::back_inserter(result.reports));
+        for (auto& error : chunk_result.errors) {
+            error.line_number += line_offset;
+            result.errors.push_back(std::move(error));
+        }
+        line_offset += chunk_result.line_count;
+    }
+
+    return result;
+}
+
+TolerantParseResult read_reactor_data_tolerant(const std::filesystem::path& file_path,
+                                               const ParseRecoveryConfig& config) {
+    return parse_reactor_data_tolerant(utils::read_file_contents(file_path), config);
 }
 
-[[nodiscard]] std::size_t report_is_safe_until(const Report& report) {
+std::size_t report_is_safe_until(const Report& report) {
     const auto& levels{report.levels()};
     const auto levels_count{levels.size()};
     if (levels_count < 2) return levels_count;
 
     if (levels[0] > levels[1]) {
         for (std::size_t i{1}; i < levels_count; ++i) {
-            const auto diff{levels[i - 1] - levels[i]};
+            const auto diff{std::int64_t{levels[i - 1]} - levels[i]};
             if (diff < 1 || diff > 3) return i;
         }
     } else if (levels[0] < levels[1]) {
         for (std::size_t i{1}; i < levels_count; ++i) {
-            const auto diff{levels[i] - levels[i - 1]};
+            const auto diff{std::int64_t{levels[i]} - levels[i - 1]};
             if (diff < 1 || diff > 3) return i;
         }
     } else {
@@ -110,41 +228,55 @@ std::ptrdiff_t count_safe_reports(const std::vector<Report>& reports) {
     return std::count_if(reports.begin(), reports.end(), report_is_safe);
 }
 
-[[nodiscard]] bool report_is_safe_with_problem_dampener(const Report& report) {
-    const auto problem_index_as_size_t{report_is_safe_until(report)};
-    // Return true if the report is safe on its own.
-    if (problem_index_as_size_t == report.levels().size()) return true;
+Expected<DampenerRemoval> try_evaluate_problem_dampener(const Report& report,
+                                                        const std::size_t problem_index) {
+    // Return early if the report is safe on its own.
+    if (problem_index == report.levels().size()) return DampenerRemoval::not_needed;
 
     // Check the range and convert to std::ptrdiff_t.
-    if (problem_index_as_size_t > std::numeric_limits<std::ptrdiff_t>::max())
-        throw OverflowException{"Problem index is out of range. Index was: " +
-                                std::to_string(problem_index_as_size_t)};
+    if (problem_index > std::numeric_limits<std::ptrdiff_t>::max())
+        return AocError::index_overflow(problem_index);
 
-    const auto problem_index{static_cast<std::ptrdiff_t>(problem_index_as_size_t)};
+    const auto problem_offset{static_cast<std::ptrdiff_t>(problem_index)};
     // Retry with the element before the problem index removed.
     auto dampened_report{report};
     auto& levels{dampened_report.levels()};
-    levels.erase(levels.cbegin() + problem_index - 1);
-    if (report_is_safe_until(dampened_report) == levels.size()) return true;
+    levels.erase(levels.cbegin() + problem_offset - 1);
+    if (report_is_safe_until(dampened_report) == levels.size()) return DampenerRemoval::previous;
     // Retry with the element at the problem index removed.
     dampened_report = report;
-    levels = dampened_report.levels();
-    levels.erase(levels.cbegin() + problem_index);
-    if (report_is_safe_until(dampened_report) == levels.size()) return true;
+    levels.erase(levels.cbegin() + problem_offset);
+    if (report_is_safe_until(dampened_report) == levels.size()) return DampenerRemoval::problem;
 
     // If the problem index is two, we also need to try with the first element removed.
-    if (problem_index == 2) {
+    if (problem_offset == 2) {
         dampened_report = report;
-        levels = dampened_report.levels();
         levels.erase(levels.cbegin());
-        if (report_is_safe_until(dampened_report) == levels.size()) return true;
+        if (report_is_safe_until(dampened_report) == levels.size()) return DampenerRemoval::first;
+    }
+
+    return DampenerRemoval::failed;
+}
+
+DampenerRemoval evaluate_problem_dampener(const Report& report, const std::size_t problem_index) {
+    return try_evaluate_problem_dampener(report, problem_index).value_or_throw();
+}
+
+Expected<std::ptrdiff_t> try_count_safe_reports_with_problem_dampener(
+    const std::vector<Report>& reports) {
+    std::ptrdiff_t safe_reports_count{0};
+
+    for (const auto& report : reports) {
+        const auto removal{try_evaluate_problem_dampener(report, report_is_safe_until(report))};
+        if (!removal) return removal.error();
+        if (*removal != DampenerRemoval::failed) ++safe_reports_count;
     }
 
-    return false;
+    return safe_reports_count;
 }
 
 std::ptrdiff_t count_safe_reports_with_problem_dampener(const std::vector<Report>& reports) {
-    return std::count_if(reports.begin(), reports.end(), report_is_safe_with_problem_dampener);
+    return try_count_safe_reports_with_problem_dampener(reports).value_or_throw();
 }
 
 }  // namespace aoc24::day2
@@ -18,9 +18,13 @@
 #define AOC24_CPP_SRC_DAY2_DAY2_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "../Expected.h"
 #include "../utils.h"
 #include "Report.h"
 
@@ -29,7 +33,8 @@ namespace aoc24::day2 {
 /**
  * @brief The path to the file containing the reactor data.
  */
-const std::filesystem::path kReactorDataFilePath{utils::kInputDir / "day2.txt"};
+inline constexpr std::string_view kReactorDataFilePath{"input/day2.txt"};
+static_assert(kReactorDataFilePath.substr(0, utils::kInputDir.size()) == utils::kInputDir);
 
 /**
  * @brief Reads and parses the reactor data from the specified source file.
@@ -42,6 +47,159 @@ const std::filesystem::path kReactorDataFilePath{utils::kInputDir / "day2.txt"};
 [[nodiscard]] std::vector<Report> read_reactor_data(
     const std::filesystem::path& file_path = kReactorDataFilePath);
 
+/**
+ * @brief Reads and parses the reactor data without throwing on failure.
+ *
+ * @param file_path The path to the file containing the reactor data.
+ * @return A vector containing each report of reactor data,
+ *         or an @c ErrorCode::file_read or @c ErrorCode::parse error for the first failure.
+ * @see read_reactor_data
+ */
+[[nodiscard]] Expected<std::vector<Report>> try_read_reactor_data(
+    const std::filesystem::path& file_path = kReactorDataFilePath);
+
+/**
+ * @brief Parses reactor data without throwing on failure.
+ *
+ * @param contents The reactor data, one report per line.
+ * @return A vector containing each report, or an @c ErrorCode::parse error for the first failure.
+ */
+[[nodiscard]] Expected<std::vector<Report>> try_parse_reactor_data(std::string_view contents);
+
+/**
+ * @brief Parses a single line of reactor data.
+ *
+ * @param line The line, without its terminator.
+ * @return The report, or an @c ErrorCode::parse error.
+ */
+[[nodiscard]] Expected<Report> try_parse_reactor_data_line(std::string_view line);
+
+/**
+ * @brief Describes a line that was skipped because it could not be parsed.
+ */
+struct LineError {
+    /** The one-based number of the line in the input. */
+    std::size_t line_number{};
+    /** The offset of the first byte of the line in the input. */
+    std::size_t byte_offset{};
+    /** The parser's description of what was wrong with the line. */
+    std::string reason{};
+};
+
+/**
+ * @brief The settings for error-tolerant parsing.
+ */
+struct ParseRecoveryConfig {
+    /** The number of threads to parse with, or zero to use one per hardware thread. */
+    std::size_t thread_count{0};
+    /** The minimum number of bytes parsed by each thread. */
+    std::size_t min_chunk_size{std::size_t{1} << 16};
+};
+
+/**
+ * @brief The outcome of error-tolerant parsing.
+ */
+struct TolerantParseResult {
+    /** The reports parsed from the well-formed lines, in input order. */
+    std::vector<Report> reports{};
+    /** The lines that were skipped, in input order. */
+    std::vector<LineError> errors{};
+};
+
+/**
+ * @brief Parses reactor data in parallel, skipping and recording malformed lines.
+ *
+ * The input is split into chunks at line boundaries that are parsed on separate threads.
+ * Each thread records its errors in its own buffer, and the buffers are merged at the end.
+ * Error descriptions are only produced for lines that fail to parse.
+ *
+ * @param contents The reactor data, one report per line.
+ * @param config The parallelism settings.
+ * @return The parsed reports and the skipped lines.
+ */
+[[nodiscard]] TolerantParseResult parse_reactor_data_tolerant(std::string_view contents,
+                                                              const ParseRecoveryConfig& config);
+
+/**
+ * @brief Reads and parses reactor data, skipping and recording malformed lines.
+ *
+ * @param file_path The path to the file containing the reactor data.
+ * @param config The parallelism settings.
+ * @return The parsed reports and the skipped lines.
+ * @throws FileReadException If the file cannot be opened or read.
+ * @see parse_reactor_data_tolerant
+ */
+[[nodiscard]] TolerantParseResult read_reactor_data_tolerant(const std::filesystem::path& file_path,
+                                                             const ParseRecoveryConfig& config);
+
+/**
+ * @brief Identifies which removal, if any, made a report safe under the problem dampener.
+ */
+enum class DampenerRemoval : std::uint8_t {
+    /** The report is safe without removing any level. */
+    not_needed,
+    /** Removing the level before the first violating position made the report safe. */
+    previous,
+    /** Removing the level at the first violating position made the report safe. */
+    problem,
+    /** Removing the first level made the report safe. */
+    first,
+    /** No single removal made the report safe. */
+    failed,
+};
+
+/**
+ * @brief Names a problem dampener removal, for diagnostics and query answers.
+ *
+ * @param removal The removal to name.
+ * @return A short lowercase name.
+ */
+[[nodiscard]] constexpr std::string_view dampener_removal_name(const DampenerRemoval removal) {
+    switch (removal) {
+        case DampenerRemoval::not_needed: return "none";
+        case DampenerRemoval::previous: return "previous";
+        case DampenerRemoval::problem: return "problem";
+        case DampenerRemoval::first: return "first";
+        case DampenerRemoval::failed: return "failed";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Finds the first position at which a report stops being safe.
+ *
+ * @param report The report to check.
+ * @return The index of the first level that violates the safety rules,
+ *         or the number of levels if the report is safe.
+ */
+[[nodiscard]] std::size_t report_is_safe_until(const Report& report);
+
+/**
+ * @brief Determines which problem dampener removal, if any, makes a report safe.
+ *
+ * @param report The report to evaluate.
+ * @param problem_index The first violating position as returned by @c report_is_safe_until.
+ * @return The removal that made the report safe,
+ *         or @c DampenerRemoval::failed if no single removal did.
+ * @throw OverflowException If @p problem_index is larger than
+ *                          @c std::numeric_limits<std::ptrdiff_t>::max().
+ */
+[[nodiscard]] DampenerRemoval evaluate_problem_dampener(const Report& report,
+                                                        std::size_t problem_index);
+
+/**
+ * @brief Determines which problem dampener removal, if any, makes a report safe,
+ *        without throwing on failure.
+ *
+ * @param report The report to evaluate.
+ * @param problem_index The first violating position as returned by @c report_is_safe_until.
+ * @return The removal that made the report safe, @c DampenerRemoval::failed if no single removal
+ *         did, or an @c ErrorCode::overflow error.
+ * @see evaluate_problem_dampener
+ */
+[[nodiscard]] Expected<DampenerRemoval> try_evaluate_problem_dampener(const Report& report,
+                                                                      std::size_t problem_index);
+
 /**
  * @brief Counts the number of safe reports in the given collection.
  *
@@ -64,6 +222,17 @@ const std::filesystem::path kReactorDataFilePath{utils::kInputDir / "day2.txt"};
 [[nodiscard]] std::ptrdiff_t count_safe_reports_with_problem_dampener(
     const std::vector<Report>& reports);
 
+/**
+ * @brief Counts safe reports when using the problem dampener, without throwing on failure.
+ *
+ * @param reports A collection of reports to evaluate.
+ * @return The count of safe reports when using the problem dampener logic,
+ *         or an @c ErrorCode::overflow error.
+ * @see count_safe_reports_with_problem_dampener
+ */
+[[nodiscard]] Expected<std::ptrdiff_t> try_count_safe_reports_with_problem_dampener(
+    const std::vector<Report>& reports);
+
 }  // namespace aoc24::day2
 
 #endif  // AOC24_CPP_SRC_DAY2_DAY2_H_
@@ -0,0 +1,126 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "diagnostics.h"
+
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifndef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+#endif
+
+#include <spdlog/fmt/compile.h>
+#include <spdlog/spdlog.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+#include <vector>
+
+#include "../AocException.h"
+
+namespace aoc24::day2 {
+
+namespace {
+
+void append_little_endian(fmt::memory_buffer& buffer, std::uint64_t value) {
+    char bytes[sizeof(value)];
+    for (auto& byte : bytes) {
+        byte = static_cast<char>(value & 0xFFU);
+        value >>= 8U;
+    }
+    buffer.append(std::begin(bytes), std::end(bytes));
+}
+
+}  // namespace
+
+DiagnosticsWriter::DiagnosticsWriter(const std::filesystem::path& file_path,
+                                     const DiagnosticsFormat format,
+                                     const std::size_t flush_threshold)
+    : file_{std::fopen(file_path.c_str(), "wb")},
+      file_path_{file_path},
+      format_{format},
+      flush_threshold_{flush_threshold} {
+    if (file_ == nullptr) throw FileWriteException{file_path, errno};
+    // We do our own buffering.
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+}
+
+DiagnosticsWriter::~DiagnosticsWriter() {
+    try {
+        flush();
+    } catch (const FileWriteException& error) {
+        SPDLOG_ERROR(error.error_message());
+    }
+    std::fclose(file_);
+}
+
+void DiagnosticsWriter::write(const std::size_t report_index, const std::size_t problem_index,
+                              const DampenerRemoval removal) {
+    if (format_ == DiagnosticsFormat::text) {
+        fmt::format_to(std::back_inserter(buffer_), FMT_COMPILE("{} {} {}\n"), report_index,
+                       problem_index, dampener_removal_name(removal));
+    } else {
+        append_little_endian(buffer_, report_index);
+        append_little_endian(buffer_, problem_index);
+        buffer_.push_back(static_cast<char>(removal));
+    }
+
+    if (buffer_.size() >= flush_threshold_) flush();
+}
+
+void DiagnosticsWriter::flush() {
+    if (buffer_.size() == 0) return;
+    const auto written{std::fwrite(buffer_.data(), 1, buffer_.size(), file_)};
+    if (written != buffer_.size()) throw FileWriteException{file_path_, errno};
+    buffer_.clear();
+}
+
+std::size_t write_unsafe_report_diagnostics(const std::vector<Report>& reports,
+                                            DiagnosticsWriter& writer) {
+    std::size_t records_written{0};
+
+    for (std::size_t i{0}; i < reports.size(); ++i) {
+        const auto& report{reports[i]};
+        const auto problem_index{report_is_safe_until(report)};
+        if (problem_index == report.levels().size()) continue;
+
+        writer.write(i, problem_index, evaluate_problem_dampener(report, problem_index));
+        ++records_written;
+    }
+
+    return records_written;
+}
+
+std::size_t write_unsafe_report_diagnostics(const ReportTable& table, DiagnosticsWriter& writer) {
+    std::size_t records_written{0};
+
+    for (std::size_t i{0}; i < table.size(); ++i) {
+        const auto removal{table.removal(i)};
+        if (removal == DampenerRemoval::not_needed) continue;
+
+        writer.write(i, table.summary(i).first_violation, removal);
+        ++records_written;
+    }
+
+    return records_written;
+}
+
+}  // namespace aoc24::day2
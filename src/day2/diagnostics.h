@@ -0,0 +1,138 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_DAY2_DIAGNOSTICS_H_
+#define AOC24_CPP_SRC_DAY2_DIAGNOSTICS_H_
+
+#include <spdlog/fmt/fmt.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+#include "Report.h"
+#include "ReportTable.h"
+#include "day2.h"
+
+namespace aoc24::day2 {
+
+/**
+ * @brief The encoding used for diagnostic records.
+ */
+enum class DiagnosticsFormat {
+    /**
+     * One record per line: the report index, the first violating position
+     * and the name of the dampener removal, separated by spaces.
+     */
+    text,
+    /**
+     * Fixed-size little-endian records of 17 bytes:
+     * the report index (8 bytes), the first violating position (8 bytes)
+     * and the dampener removal (1 byte).
+     */
+    binary,
+};
+
+/**
+ * @brief Buffered sink that writes per-report diagnostic records to a file.
+ *
+ * Records are formatted into a reusable memory buffer
+ * that is only written to the file once it grows past the flush threshold,
+ * so writing a record does not allocate or perform I/O in the common case.
+ */
+class DiagnosticsWriter final {
+    std::FILE* file_{};
+    std::filesystem::path file_path_{};
+    DiagnosticsFormat format_{};
+    std::size_t flush_threshold_{};
+    fmt::memory_buffer buffer_{};
+
+  public:
+    /**
+     * @brief The default number of bytes buffered before writing to the file.
+     */
+    static constexpr std::size_t kDefaultFlushThreshold{std::size_t{1} << 20};
+
+    /**
+     * @brief Opens a diagnostics file for writing, truncating it if it exists.
+     *
+     * @param file_path The path of the file to write the records to.
+     * @param format The encoding of the records.
+     * @param flush_threshold The number of buffered bytes after which the buffer is written out.
+     * @throws FileWriteException If the file cannot be opened.
+     */
+    DiagnosticsWriter(const std::filesystem::path& file_path, DiagnosticsFormat format,
+                      std::size_t flush_threshold = kDefaultFlushThreshold);
+
+    DiagnosticsWriter(const DiagnosticsWriter& other) = delete;
+    DiagnosticsWriter(DiagnosticsWriter&& other) = delete;
+    DiagnosticsWriter& operator=(const DiagnosticsWriter& other) = delete;
+    DiagnosticsWriter& operator=(DiagnosticsWriter&& other) = delete;
+
+    /**
+     * @brief Flushes any buffered records and closes the file.
+     *
+     * Errors during this final flush are logged instead of thrown.
+     * Call @c flush explicitly to observe them.
+     */
+    ~DiagnosticsWriter();
+
+    /**
+     * @brief Appends a record for a single unsafe report.
+     *
+     * @param report_index The index of the report in its collection.
+     * @param problem_index The first violating position as returned by @c report_is_safe_until.
+     * @param removal The problem dampener removal that made the report safe, if any.
+     * @throws FileWriteException If the buffer had to be flushed and writing failed.
+     */
+    void write(std::size_t report_index, std::size_t problem_index, DampenerRemoval removal);
+
+    /**
+     * @brief Writes all buffered records to the file.
+     *
+     * @throws FileWriteException If writing fails.
+     */
+    void flush();
+};
+
+/**
+ * @brief Writes a diagnostic record for every report that is not safe on its own.
+ *
+ * @param reports The reports to evaluate.
+ * @param writer The sink to write the records to.
+ * @return The number of records written.
+ * @throws FileWriteException If writing fails.
+ * @throws OverflowException Possibly, when a report is larger than
+ *                           @c std::numeric_limits<std::ptrdiff_t>::max().
+ */
+std::size_t write_unsafe_report_diagnostics(const std::vector<Report>& reports,
+                                            DiagnosticsWriter& writer);
+
+/**
+ * @brief Writes a diagnostic record for every report that is not safe on its own,
+ *        from the outcomes already stored in a report table.
+ *
+ * @param table The evaluated reports.
+ * @param writer The sink to write the records to.
+ * @return The number of records written.
+ * @throws FileWriteException If writing fails.
+ */
+std::size_t write_unsafe_report_diagnostics(const ReportTable& table, DiagnosticsWriter& writer);
+
+}  // namespace aoc24::day2
+
+#endif  // AOC24_CPP_SRC_DAY2_DIAGNOSTICS_H_
@@ -0,0 +1,167 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "logging.h"
+
+#include <spdlog/async.h>
+#include <spdlog/sinks/sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace aoc24::logging {
+
+namespace {
+
+constexpr auto kPattern{"%Y-%m-%d %T.%e%z [%^%l%$] %s:%# - %v"};
+
+std::atomic<std::uint32_t> parse_error_burst{10};
+std::atomic<std::uint32_t> parse_errors_per_second{1};
+// Suppressed messages on all threads that no later message has reported yet.
+std::atomic<std::uint64_t> unreported_suppressed_count{0};
+
+/**
+ * @brief Token bucket limiting how many messages a single thread may log.
+ */
+class RateLimiter final {
+    using Clock = std::chrono::steady_clock;
+
+    double tokens_{static_cast<double>(parse_error_burst.load(std::memory_order_relaxed))};
+    Clock::time_point last_refill_{Clock::now()};
+    std::uint64_t suppressed_count_{0};
+
+  public:
+    [[nodiscard]] bool acquire(std::uint64_t& suppressed_count) noexcept {
+        const auto burst{static_cast<double>(parse_error_burst.load(std::memory_order_relaxed))};
+        const auto rate{
+            static_cast<double>(parse_errors_per_second.load(std::memory_order_relaxed))};
+
+        const auto now{Clock::now()};
+        const std::chrono::duration<double> elapsed{now - last_refill_};
+        last_refill_ = now;
+        tokens_ = std::min(burst, tokens_ + elapsed.count() * rate);
+
+        if (tokens_ < 1.0) {
+            ++suppressed_count_;
+            unreported_suppressed_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        tokens_ -= 1.0;
+        unreported_suppressed_count.fetch_sub(suppressed_count_, std::memory_order_relaxed);
+        suppressed_count = suppressed_count_;
+        suppressed_count_ = 0;
+        return true;
+    }
+};
+
+[[nodiscard]] spdlog::async_overflow_policy to_spdlog(const OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::block: return spdlog::async_overflow_policy::block;
+        case OverflowPolicy::overrun_oldest: return spdlog::async_overflow_policy::overrun_oldest;
+    }
+    return spdlog::async_overflow_policy::block;
+}
+
+/**
+ * @brief Defers creating the real logger, and the thread pool in async mode, to the first message.
+ *
+ * Most runs log nothing at the default level,
+ * so this keeps the terminal sink and the background threads off the startup path.
+ */
+class LazySink final : public spdlog::sinks::sink {
+    LoggerConfig config_{};
+    std::once_flag once_{};
+    std::atomic<bool> created_{false};
+    std::shared_ptr<spdlog::logger> target_{};
+
+    spdlog::logger& target() {
+        std::call_once(once_, [this] {
+            const auto sink{std::make_shared<spdlog::sinks::stderr_color_sink_mt>()};
+            if (config_.mode == LogMode::async) {
+                spdlog::init_thread_pool(config_.queue_size, config_.thread_count);
+                target_ = std::make_shared<spdlog::async_logger>(
+                    "main", sink, spdlog::thread_pool(), to_spdlog(config_.overflow_policy));
+            } else {
+                target_ = std::make_shared<spdlog::logger>("main", sink);
+            }
+            // The outer logger already filtered by level.
+            target_->set_level(spdlog::level::trace);
+            target_->set_pattern(kPattern);
+            created_.store(true, std::memory_order_release);
+        });
+        return *target_;
+    }
+
+  public:
+    explicit LazySink(LoggerConfig config) : config_{std::move(config)} {}
+
+    void log(const spdlog::details::log_msg& msg) override {
+        target().log(msg.time, msg.source, msg.level, msg.payload);
+    }
+
+    void flush() override {
+        if (created_.load(std::memory_order_acquire)) target_->flush();
+    }
+
+    // The real logger always uses kPattern.
+    void set_pattern(const std::string&) override {}
+    void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+};
+
+}  // namespace
+
+bool is_valid_level(const std::string_view level) {
+    // `from_str` maps unknown names to `off`, so check for that name explicitly.
+    return level == "off" || spdlog::level::from_str(std::string{level}) != spdlog::level::off;
+}
+
+void configure_logger(const LoggerConfig& config) {
+    parse_error_burst.store(config.parse_error_burst, std::memory_order_relaxed);
+    parse_errors_per_second.store(config.parse_errors_per_second, std::memory_order_relaxed);
+
+    const auto logger{
+        std::make_shared<spdlog::logger>("main", std::make_shared<LazySink>(config))};
+    logger->set_level(spdlog::level::from_str(config.level));
+    // Make sure errors reach the terminal before the process exits or crashes.
+    logger->flush_on(spdlog::level::err);
+    spdlog::set_default_logger(logger);
+}
+
+void shutdown_logger() {
+    // A final burst of parse errors is never followed by a message that reports it.
+    const auto suppressed_count{
+        unreported_suppressed_count.exchange(0, std::memory_order_relaxed)};
+    if (suppressed_count != 0)
+        spdlog::warn("Suppressed {} more parse error messages.", suppressed_count);
+    spdlog::shutdown();
+}
+
+bool acquire_parse_error_token(std::uint64_t& suppressed_count) noexcept {
+    thread_local RateLimiter limiter{};
+    return limiter.acquire(suppressed_count);
+}
+
+}  // namespace aoc24::logging
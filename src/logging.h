@@ -0,0 +1,124 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_LOGGING_H_
+#define AOC24_CPP_SRC_LOGGING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// This header deliberately does not include spdlog,
+// so that it can be included before a translation unit selects its SPDLOG_ACTIVE_LEVEL.
+
+namespace aoc24::logging {
+
+/**
+ * @brief How log messages are delivered to the sink.
+ */
+enum class LogMode {
+    /** Messages are written to stderr on the calling thread. */
+    sync,
+    /** Messages are queued and written to stderr by a background thread pool. */
+    async,
+};
+
+/**
+ * @brief What the asynchronous logger does when its queue is full.
+ */
+enum class OverflowPolicy {
+    /** The logging thread waits until there is room in the queue. */
+    block,
+    /** The oldest queued message is discarded to make room. */
+    overrun_oldest,
+};
+
+/**
+ * @brief The settings for the process-wide logger.
+ */
+struct LoggerConfig {
+    /** How log messages are delivered. */
+    LogMode mode{LogMode::sync};
+    /** The number of messages the asynchronous queue can hold. */
+    std::size_t queue_size{8192};
+    /** The number of background threads writing asynchronous messages. */
+    std::size_t thread_count{1};
+    /** What to do when the asynchronous queue is full. */
+    OverflowPolicy overflow_policy{OverflowPolicy::overrun_oldest};
+    /** The runtime log level, as accepted by @c is_valid_level. */
+    std::string level{"info"};
+    /** The number of non-fatal parse errors each thread may log in a burst. */
+    std::uint32_t parse_error_burst{10};
+    /** The number of non-fatal parse errors each thread may log per second after a burst. */
+    std::uint32_t parse_errors_per_second{1};
+};
+
+/**
+ * @brief Checks whether a string names a log level.
+ *
+ * @param level The level name, such as "trace", "info" or "off".
+ * @return True if @p level names a log level, false otherwise.
+ */
+[[nodiscard]] bool is_valid_level(std::string_view level);
+
+/**
+ * @brief Installs the process-wide default logger.
+ *
+ * Both modes use a thread-safe sink,
+ * so the logger can be used from parallel parse and evaluate paths.
+ * The sink, and the thread pool in async mode, are only created when the first message is logged,
+ * so runs that log nothing do not pay for them at startup.
+ *
+ * @param config The logger settings.
+ */
+void configure_logger(const LoggerConfig& config);
+
+/**
+ * @brief Reports parse error messages that were suppressed and not yet counted in a later message,
+ *        then flushes pending messages and stops the asynchronous thread pool, if any.
+ */
+void shutdown_logger();
+
+/**
+ * @brief Takes a token from the calling thread's parse error rate limiter.
+ *
+ * @param suppressed_count Set to the number of messages that were suppressed
+ *                         since the previous successful call on this thread.
+ * @return True if the message may be logged, false if it should be suppressed.
+ */
+[[nodiscard]] bool acquire_parse_error_token(std::uint64_t& suppressed_count) noexcept;
+
+}  // namespace aoc24::logging
+
+/**
+ * @brief Logs a non-fatal parse error, subject to the per-thread rate limit.
+ *
+ * Messages that exceed the limit are dropped and counted in the next message that is let through,
+ * or by @c aoc24::logging::shutdown_logger if there is none.
+ */
+#define AOC24_LOG_PARSE_ERROR(message)                                                \
+    do {                                                                              \
+        std::uint64_t aoc24_suppressed_count_{0};                                     \
+        if (::aoc24::logging::acquire_parse_error_token(aoc24_suppressed_count_)) {   \
+            if (aoc24_suppressed_count_ != 0)                                         \
+                SPDLOG_WARN("Suppressed {} parse error messages on this thread.",     \
+                            aoc24_suppressed_count_);                                 \
+            SPDLOG_ERROR(message);                                                    \
+        }                                                                             \
+    } while (false)
+
+#endif  // AOC24_CPP_SRC_LOGGING_H_
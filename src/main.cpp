@@ -14,21 +14,43 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#ifndef SPDLOG_ACTIVE_LEVEL
 #ifndef NDEBUG
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
 #else
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
 #endif
+#endif
 
-#include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
-#include <iostream>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
 #include <vector>
 
 #include "AocException.h"
+#include "Options.h"
+#include "day1/SimilaritySketch.h"
+#include "day1/day1.h"
+#include "day1/external_sort.h"
 #include "day2/Report.h"
+#include "day2/ReportTable.h"
 #include "day2/day2.h"
+#include "day2/diagnostics.h"
+#include "logging.h"
+#include "perf/perf.h"
+#include "server/server.h"
+#include "shard/shard.h"
+#include "utils.h"
+#include "watch/watch.h"
 
 using namespace aoc24;
 
@@ -36,46 +58,220 @@ enum class ExitCode : int {
     success = 0,
     file_read_error,
     parse_error,
+    file_write_error,
+    usage_error,
+    worker_error,
+    socket_error,
 };
 
-void configure_logger() {
-    const auto logger{spdlog::stderr_color_st("main")};
-    logger->set_level(spdlog::level::info);
-    logger->set_pattern("%Y-%m-%d %T.%e%z [%^%l%$] %s:%# - %v");
-    spdlog::set_default_logger(logger);
+ExitCode report_failure(const AocException& error, const ExitCode exit_code) {
+    SPDLOG_CRITICAL(error.error_message());
+    fmt::print("{}\n", error.user_message());
+    return exit_code;
 }
 
-ExitCode program() {
+std::filesystem::path input_path(const Options& options) {
+    if (options.input_path) return *options.input_path;
+    return options.day == 1 ? day1::kLocationListsFilePath : day2::kReactorDataFilePath;
+}
+
+void run_day1(const Options& options) {
+    if (options.sketch) {
+        const auto sketch{day1::sketch_location_lists(input_path(options), options.sketch_config)};
+        SPDLOG_INFO("The similarity sketch uses {} bytes.", sketch.memory_usage());
+        fmt::print(
+            "The similarity score is approximately {:.0f} (at most {:.0f} too high with "
+            "probability {}).\n",
+            sketch.estimate(), sketch.error_bound(), sketch.confidence());
+        return;
+    }
+
+    if (options.external_sort) {
+        const auto result{
+            day1::calculate_totals_external(input_path(options), options.external_sort_config)};
+        SPDLOG_INFO("Spilled {} sorted runs per list.", result.run_count);
+        fmt::print("The total distance is {}.\n", result.total_distance);
+        fmt::print("The similarity score is {}.\n", result.similarity_score);
+        return;
+    }
+
+    perf::PhaseRecorder recorder{options.stats};
+    const auto path{input_path(options)};
+    const auto contents{recorder.measure("read", [&] { return utils::read_file_contents(path); })};
+    auto lists{recorder.measure(
+        "parse", [&] { return day1::try_parse_location_lists(contents, path).value_or_throw(); })};
+    recorder.measure("sort", [&] {
+        std::sort(lists.first.begin(), lists.first.end());
+        std::sort(lists.second.begin(), lists.second.end());
+    });
+    const auto [total_distance, similarity_score]{recorder.measure("evaluate", [&] {
+        return std::make_pair(day1::sum_of_distances(lists.first, lists.second),
+                              day1::calculate_similarity_score_sorted(lists.first, lists.second));
+    })};
+
+    fmt::print("The total distance is {}.\n", total_distance);
+    fmt::print("The similarity score is {}.\n", similarity_score);
+    if (options.stats) fmt::print(stderr, "{}", recorder.format_table());
+}
+
+void run_day2(const Options& options) {
+    perf::PhaseRecorder recorder{options.stats};
+    const auto contents{recorder.measure(
+        "read", [&] { return utils::read_file_contents(input_path(options)); })};
     std::vector<day2::Report> reports{};
 
+    if (options.recover_parse_errors) {
+        auto result{recorder.measure("parse", [&] {
+            return day2::parse_reactor_data_tolerant(contents, options.parse_recovery);
+        })};
+        for (const auto& error : result.errors)
+            AOC24_LOG_PARSE_ERROR(fmt::format("Skipped line {} (byte {}): {}", error.line_number,
+                                              error.byte_offset, error.reason));
+        if (!result.errors.empty())
+            fmt::print("Skipped {} malformed lines.\n", result.errors.size());
+        reports = std::move(result.reports);
+    } else {
+        reports = recorder.measure(
+            "parse", [&] { return day2::try_parse_reactor_data(contents).value_or_throw(); });
+    }
+
+    std::optional<day2::ReportTable> table{};
+    if (options.columnar) {
+        recorder.measure("index", [&] { table.emplace(reports); });
+        SPDLOG_DEBUG("The report table uses {} bytes.", table->memory_usage());
+    }
+
+    const auto safe_reports_count{recorder.measure("evaluate", [&] {
+        return table ? static_cast<std::ptrdiff_t>(table->count_safe_with_problem_dampener())
+                     : day2::count_safe_reports_with_problem_dampener(reports);
+    })};
+
+    if (options.diagnostics_path) {
+        day2::DiagnosticsWriter writer{*options.diagnostics_path, options.diagnostics_format};
+        const auto records_written{recorder.measure("diagnostics", [&] {
+            const auto count{table ? day2::write_unsafe_report_diagnostics(*table, writer)
+                                   : day2::write_unsafe_report_diagnostics(reports, writer)};
+            writer.flush();
+            return count;
+        })};
+        SPDLOG_INFO("Wrote {} diagnostic records to {}.", records_written,
+                    options.diagnostics_path->string());
+    }
+
+    fmt::print("There are {} safe reports.\n", safe_reports_count);
+    if (options.stats) fmt::print(stderr, "{}", recorder.format_table());
+}
+
+void run_shard_worker(const Options& options) {
+    const auto& partial_path{*options.partial_path};
+
+    if (options.day == 1) {
+        const auto partial{
+            shard::compute_day1_partial(input_path(options), *options.shard_range, partial_path)};
+        shard::write_partial(partial_path, partial);
+    } else {
+        const auto partial{shard::compute_day2_partial(input_path(options), *options.shard_range)};
+        shard::write_partial(partial_path, partial);
+    }
+}
+
+void print_merged_partials(const int day, const std::vector<std::filesystem::path>& partial_paths) {
+    if (day == 1) {
+        std::vector<shard::Day1Partial> partials{};
+        for (const auto& partial_path : partial_paths)
+            partials.push_back(shard::read_day1_partial(partial_path));
+        const auto totals{shard::merge_partials(partials)};
+        fmt::print("The total distance is {}.\n", totals.total_distance);
+        fmt::print("The similarity score is {}.\n", totals.similarity_score);
+    } else {
+        std::vector<shard::Day2Partial> partials{};
+        for (const auto& partial_path : partial_paths)
+            partials.push_back(shard::read_day2_partial(partial_path));
+        const auto totals{shard::merge_partials(partials)};
+        fmt::print("There are {} safe reports without and {} safe reports with the problem "
+                   "dampener.\n",
+                   totals.safe_count, totals.dampened_safe_count);
+    }
+}
+
+void run_shard_coordinator(const Options& options) {
+    std::error_code error{};
+    auto work_dir{options.work_dir.value_or(std::filesystem::path{})};
+    if (!options.work_dir) {
+        work_dir = std::filesystem::temp_directory_path(error) /
+                   ("aoc24-shards-" + std::to_string(getpid()));
+        if (error) throw FileWriteException{"the temporary directory", error.value()};
+    }
+    std::filesystem::create_directories(work_dir, error);
+    if (error) throw FileWriteException{work_dir, error.value()};
+
+    // Only clean up directories we created ourselves.
+    const auto remove_work_dir{[&] {
+        if (options.work_dir) return;
+        std::error_code remove_error{};
+        std::filesystem::remove_all(work_dir, remove_error);
+        if (remove_error)
+            SPDLOG_WARN("Failed to remove {}: {}", work_dir.string(), remove_error.message());
+    }};
+
     try {
-        reports = day2::read_reactor_data();
-    } catch (const FileReadException& error) {
-        SPDLOG_CRITICAL(error.error_message());
-        std::cout << error.user_message() << '\n';
-        return ExitCode::file_read_error;
-    } catch (const ParseException& error) {
-        SPDLOG_CRITICAL(error.error_message());
-        std::cout << error.user_message() << '\n';
-        return ExitCode::parse_error;
+        const std::filesystem::path self{"/proc/self/exe"};
+        const auto executable{std::filesystem::read_symlink(self, error)};
+        if (error) throw FileReadException{self, error.value()};
+        print_merged_partials(options.day,
+                              shard::run_local_workers(executable, options.day, input_path(options),
+                                                       options.shard_count, work_dir));
+    } catch (...) {
+        remove_work_dir();
+        throw;
     }
 
-    std::ptrdiff_t safe_reports_count{};
+    remove_work_dir();
+}
 
+ExitCode program(const Options& options) {
     try {
-        safe_reports_count = day2::count_safe_reports_with_problem_dampener(reports);
+        if (options.serve) {
+            server::serve(options.server_config);
+        } else if (options.watch) {
+            watch::watch_input(options.day, input_path(options), options.watch_config);
+        } else if (options.shard_range) {
+            run_shard_worker(options);
+        } else if (options.shard_count > 0) {
+            run_shard_coordinator(options);
+        } else if (options.day == 1) {
+            run_day1(options);
+        } else {
+            run_day2(options);
+        }
+    } catch (const FileReadException& error) {
+        return report_failure(error, ExitCode::file_read_error);
+    } catch (const ParseException& error) {
+        return report_failure(error, ExitCode::parse_error);
     } catch (const OverflowException& error) {
-        SPDLOG_CRITICAL(error.error_message());
-        std::cout << error.user_message() << '\n';
-        return ExitCode::parse_error;
+        return report_failure(error, ExitCode::parse_error);
+    } catch (const FileWriteException& error) {
+        return report_failure(error, ExitCode::file_write_error);
+    } catch (const WorkerException& error) {
+        return report_failure(error, ExitCode::worker_error);
+    } catch (const SocketException& error) {
+        return report_failure(error, ExitCode::socket_error);
     }
 
-    std::cout << "There are " << safe_reports_count << " safe reports.\n";
     return ExitCode::success;
 }
 
-int main() {
-    configure_logger();
-    const auto exit_code{program()};
+int main(const int argc, const char* const argv[]) {
+    Options options{};
+    try {
+        options = parse_options(argc, argv);
+    } catch (const UsageException& error) {
+        fmt::print("{}\n", error.user_message());
+        return static_cast<int>(ExitCode::usage_error);
+    }
+
+    logging::configure_logger(options.logger);
+    const auto exit_code{program(options)};
+    logging::shutdown_logger();
     return static_cast<int>(exit_code);
 }
@@ -0,0 +1,158 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "footprint.h"
+
+#include <fcntl.h>
+#include <malloc.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string_view>
+
+namespace aoc24::memory {
+
+namespace {
+
+std::atomic<std::uint64_t> heap_bytes_in_use{0};
+std::atomic<std::uint64_t> heap_bytes_peak{0};
+
+#ifdef AOC24_TRACK_ALLOCATIONS
+void raise_heap_peak(const std::uint64_t bytes) {
+    auto peak{heap_bytes_peak.load(std::memory_order_relaxed)};
+    while (bytes > peak &&
+           !heap_bytes_peak.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+    }
+}
+
+void record_allocation(void* pointer) {
+    const auto size{malloc_usable_size(pointer)};
+    raise_heap_peak(heap_bytes_in_use.fetch_add(size, std::memory_order_relaxed) + size);
+}
+
+void record_deallocation(void* pointer) {
+    heap_bytes_in_use.fetch_sub(malloc_usable_size(pointer), std::memory_order_relaxed);
+}
+#endif
+
+/**
+ * @brief Reads a small file from @c /proc into a buffer and returns its contents.
+ */
+[[nodiscard]] std::string_view read_proc_file(const char* path, char (&buffer)[4096]) {
+    const int descriptor{open(path, O_RDONLY | O_CLOEXEC)};
+    if (descriptor < 0) return {};
+    const auto size{read(descriptor, buffer, sizeof(buffer))};
+    close(descriptor);
+    if (size <= 0) return {};
+    return std::string_view{buffer, static_cast<std::size_t>(size)};
+}
+
+/**
+ * @brief Parses the number after @p key in a @c /proc file of "Key: value" lines.
+ */
+[[nodiscard]] std::uint64_t parse_proc_field(const std::string_view contents,
+                                             const std::string_view key) {
+    const auto position{contents.find(key)};
+    if (position == std::string_view::npos) return 0;
+    auto value{contents.substr(position + key.size())};
+    value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+    std::uint64_t number{0};
+    std::from_chars(value.data(), value.data() + value.size(), number);
+    return number;
+}
+
+}  // namespace
+
+bool allocations_tracked() {
+#ifdef AOC24_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::optional<std::uint64_t> heap_bytes() {
+    if (!allocations_tracked()) return std::nullopt;
+    return heap_bytes_in_use.load(std::memory_order_relaxed);
+}
+
+std::optional<std::uint64_t> peak_heap_bytes() {
+    if (!allocations_tracked()) return std::nullopt;
+    return heap_bytes_peak.load(std::memory_order_relaxed);
+}
+
+void reset_peak_heap() {
+    heap_bytes_peak.store(heap_bytes_in_use.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+}
+
+std::uint64_t rss_bytes() {
+    char buffer[4096];
+    const auto statm{read_proc_file("/proc/self/statm", buffer)};
+    // The second field is the resident size in pages.
+    const auto resident{statm.substr(std::min(statm.find(' ') + 1, statm.size()))};
+    std::uint64_t pages{0};
+    std::from_chars(resident.data(), resident.data() + resident.size(), pages);
+    return pages * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+}
+
+std::uint64_t peak_rss_bytes() {
+    char buffer[4096];
+    return parse_proc_field(read_proc_file("/proc/self/status", buffer), "VmHWM:") * 1024;
+}
+
+bool reset_peak_rss() {
+    const int descriptor{open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC)};
+    if (descriptor < 0) return false;
+    const bool reset{write(descriptor, "5", 1) == 1};
+    close(descriptor);
+    return reset;
+}
+
+}  // namespace aoc24::memory
+
+#ifdef AOC24_TRACK_ALLOCATIONS
+
+// Only the basic forms are replaced: the array, nothrow and sized forms call them,
+// and over-aligned allocations are neither counted nor freed here.
+
+void* operator new(const std::size_t size) {
+    // Like the default implementation, give the new-handler a chance to free memory
+    // and only fail once there is none.
+    void* pointer{};
+    while ((pointer = std::malloc(size == 0 ? 1 : size)) == nullptr) {
+        const auto handler{std::get_new_handler()};
+        if (handler == nullptr) throw std::bad_alloc{};
+        handler();
+    }
+    aoc24::memory::record_allocation(pointer);
+    return pointer;
+}
+
+void operator delete(void* const pointer) noexcept {
+    if (pointer == nullptr) return;
+    aoc24::memory::record_deallocation(pointer);
+    std::free(pointer);
+}
+
+void operator delete(void* const pointer, std::size_t) noexcept { operator delete(pointer); }
+
+#endif
@@ -0,0 +1,71 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_MEMORY_FOOTPRINT_H_
+#define AOC24_CPP_SRC_MEMORY_FOOTPRINT_H_
+
+#include <cstdint>
+#include <optional>
+
+namespace aoc24::memory {
+
+/**
+ * @brief Checks whether heap allocations are being counted.
+ *
+ * They are when the build enables the @c AOC24_TRACK_ALLOCATIONS CMake option,
+ * which replaces the global @c operator new and @c operator delete.
+ */
+[[nodiscard]] bool allocations_tracked();
+
+/**
+ * @brief Returns the number of heap bytes in use, if allocations are tracked.
+ *
+ * Sizes are the usable sizes reported by the allocator, so they include its rounding.
+ */
+[[nodiscard]] std::optional<std::uint64_t> heap_bytes();
+
+/**
+ * @brief Returns the highest number of heap bytes in use since the last reset,
+ *        if allocations are tracked.
+ */
+[[nodiscard]] std::optional<std::uint64_t> peak_heap_bytes();
+
+/**
+ * @brief Restarts the heap peak at the number of bytes currently in use.
+ */
+void reset_peak_heap();
+
+/**
+ * @brief Returns the resident set size of the process in bytes, or zero if it is unknown.
+ */
+[[nodiscard]] std::uint64_t rss_bytes();
+
+/**
+ * @brief Returns the highest resident set size of the process in bytes, or zero if it is unknown.
+ */
+[[nodiscard]] std::uint64_t peak_rss_bytes();
+
+/**
+ * @brief Restarts the resident set size peak at the current size.
+ *
+ * @return True on success, or false if the kernel does not allow it,
+ *         in which case the peak covers the whole run so far.
+ */
+bool reset_peak_rss();
+
+}  // namespace aoc24::memory
+
+#endif  // AOC24_CPP_SRC_MEMORY_FOOTPRINT_H_
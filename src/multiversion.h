@@ -0,0 +1,38 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_MULTIVERSION_H_
+#define AOC24_CPP_SRC_MULTIVERSION_H_
+
+/**
+ * @def AOC24_MULTIVERSION
+ * @brief Compiles a function once per listed instruction set and picks one at load time.
+ *
+ * Only used on loops the compiler vectorizes, where wider registers pay off.
+ * Enabled with the @c AOC24_MULTIVERSIONING CMake option on x86-64 compilers that support
+ * @c target_clones. Otherwise the function is compiled once for the selected @c -march.
+ */
+#if defined(AOC24_MULTIVERSIONING) && defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define AOC24_MULTIVERSION __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+
+#ifndef AOC24_MULTIVERSION
+#define AOC24_MULTIVERSION
+#endif
+
+#endif  // AOC24_CPP_SRC_MULTIVERSION_H_
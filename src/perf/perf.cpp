@@ -0,0 +1,225 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "perf.h"
+
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifndef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+#endif
+
+#include <linux/perf_event.h>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "../memory/footprint.h"
+
+namespace aoc24::perf {
+
+namespace {
+
+constexpr std::string_view kEventNames[kEventCount]{
+    "cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses", "page-faults",
+};
+
+/**
+ * @brief The kernel's event type and configuration for each event.
+ */
+constexpr std::pair<std::uint32_t, std::uint64_t> kEventConfigs[kEventCount]{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+};
+
+/**
+ * @brief The value read from a counter opened with the read format below.
+ */
+struct CounterReading {
+    std::uint64_t value;
+    std::uint64_t time_enabled;
+    std::uint64_t time_running;
+};
+
+[[nodiscard]] int open_counter(const Event event) {
+    const auto [type, config]{kEventConfigs[static_cast<std::size_t>(event)]};
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = type;
+    attributes.config = config;
+    attributes.disabled = 1;
+    attributes.inherit = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(
+        syscall(SYS_perf_event_open, &attributes, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+[[nodiscard]] std::string_view describe_open_error(const int error) {
+    switch (error) {
+        case EACCES:
+        case EPERM:
+            return "not permitted, see /proc/sys/kernel/perf_event_paranoid";
+        case ENOSYS:
+            return "perf_event_open is not available";
+        default:
+            return "not supported by this CPU or virtual machine";
+    }
+}
+
+[[nodiscard]] std::string format_count(const std::optional<std::uint64_t>& count) {
+    return count ? std::to_string(*count) : "n/a";
+}
+
+[[nodiscard]] std::string format_mebibytes(const std::optional<std::uint64_t>& bytes) {
+    return bytes ? fmt::format("{:.1f}", static_cast<double>(*bytes) / (1 << 20)) : "n/a";
+}
+
+}  // namespace
+
+std::string_view event_name(const Event event) {
+    return kEventNames[static_cast<std::size_t>(event)];
+}
+
+EventCounters::EventCounters() {
+    std::vector<std::string_view> unavailable_names{};
+    int first_error{0};
+
+    for (std::size_t i{0}; i < kEventCount; ++i) {
+        const auto event{static_cast<Event>(i)};
+        descriptors_[i] = open_counter(event);
+        if (descriptors_[i] >= 0) continue;
+
+        if (first_error == 0) first_error = errno;
+        SPDLOG_DEBUG("Cannot count {}: {}", event_name(event), std::strerror(errno));
+        unavailable_names.push_back(event_name(event));
+    }
+
+    if (!unavailable_names.empty())
+        unavailable_reason_ = fmt::format("Not counted: {} ({}: {}).",
+                                          fmt::join(unavailable_names, ", "),
+                                          std::strerror(first_error),
+                                          describe_open_error(first_error));
+}
+
+EventCounters::~EventCounters() {
+    for (const auto descriptor : descriptors_)
+        if (descriptor >= 0) close(descriptor);
+}
+
+bool EventCounters::available(const Event event) const {
+    return descriptors_[static_cast<std::size_t>(event)] >= 0;
+}
+
+void EventCounters::start() {
+    for (const auto descriptor : descriptors_) {
+        if (descriptor < 0) continue;
+        ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+        ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+EventCounts EventCounters::stop() {
+    for (const auto descriptor : descriptors_)
+        if (descriptor >= 0) ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+    EventCounts counts{};
+    for (std::size_t i{0}; i < kEventCount; ++i) {
+        CounterReading reading{};
+        if (descriptors_[i] < 0 ||
+            read(descriptors_[i], &reading, sizeof(reading)) != sizeof(reading) ||
+            reading.time_running == 0)
+            continue;
+
+        // Extrapolate when the counter only ran for part of the time, like perf stat does.
+        counts[i] = reading.time_running < reading.time_enabled
+                        ? static_cast<std::uint64_t>(static_cast<double>(reading.value) *
+                                                     static_cast<double>(reading.time_enabled) /
+                                                     static_cast<double>(reading.time_running))
+                        : reading.value;
+    }
+    return counts;
+}
+
+PhaseRecorder::Scope::Scope(PhaseRecorder& recorder, const std::string_view name)
+    : recorder_{recorder} {
+    recorder_.phases_.push_back({std::string{name}, 0.0, {}, 0, std::nullopt});
+    memory::reset_peak_rss();
+    memory::reset_peak_heap();
+    if (recorder_.counters_) recorder_.counters_->start();
+    start_ = std::chrono::steady_clock::now();
+}
+
+PhaseRecorder::Scope::~Scope() {
+    const std::chrono::duration<double, std::milli> elapsed{std::chrono::steady_clock::now() -
+                                                            start_};
+    auto& phase{recorder_.phases_.back()};
+    phase.wall_ms = elapsed.count();
+    if (recorder_.counters_) phase.counts = recorder_.counters_->stop();
+    phase.peak_rss_bytes = memory::peak_rss_bytes();
+    phase.peak_heap_bytes = memory::peak_heap_bytes();
+}
+
+PhaseRecorder::PhaseRecorder(const bool enabled)
+    : enabled_{enabled}, counters_{enabled ? std::make_unique<EventCounters>() : nullptr} {}
+
+std::string PhaseRecorder::format_table() const {
+    std::size_t name_width{std::string_view{"phase"}.size()};
+    for (const auto& phase : phases_) name_width = std::max(name_width, phase.name.size());
+
+    std::string table{fmt::format("{:>{}} {:>10}", "phase", name_width, "wall ms")};
+    for (const auto name : kEventNames) table += fmt::format(" {:>14}", name);
+    table += fmt::format(" {:>6} {:>13} {:>14}\n", "IPC", "peak RSS MiB", "peak heap MiB");
+
+    const auto cycles_index{static_cast<std::size_t>(Event::cycles)};
+    const auto instructions_index{static_cast<std::size_t>(Event::instructions)};
+    for (const auto& phase : phases_) {
+        table += fmt::format("{:>{}} {:>10.3f}", phase.name, name_width, phase.wall_ms);
+        for (const auto& count : phase.counts)
+            table += fmt::format(" {:>14}", format_count(count));
+
+        const auto& cycles{phase.counts[cycles_index]};
+        const auto& instructions{phase.counts[instructions_index]};
+        if (cycles && instructions && *cycles != 0)
+            table += fmt::format(" {:>6.2f}", static_cast<double>(*instructions) /
+                                                  static_cast<double>(*cycles));
+        else
+            table += fmt::format(" {:>6}", "n/a");
+        table += fmt::format(" {:>13} {:>14}\n", format_mebibytes(phase.peak_rss_bytes),
+                             format_mebibytes(phase.peak_heap_bytes));
+    }
+
+    if (counters_ && !counters_->unavailable_reason().empty())
+        table += counters_->unavailable_reason() + '\n';
+    return table;
+}
+
+}  // namespace aoc24::perf
@@ -0,0 +1,195 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_PERF_PERF_H_
+#define AOC24_CPP_SRC_PERF_PERF_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace aoc24::perf {
+
+/**
+ * @brief The events counted for each phase of a run.
+ */
+enum class Event {
+    cycles,
+    instructions,
+    branch_misses,
+    /** Level 1 data cache read misses. */
+    l1d_misses,
+    /** Cache misses as reported by the CPU, which usually means last level cache misses. */
+    llc_misses,
+    /** Page faults, a software event that is also available in virtual machines. */
+    page_faults,
+};
+
+/**
+ * @brief The number of values of @c Event.
+ */
+inline constexpr std::size_t kEventCount{6};
+
+/**
+ * @brief Returns the column heading for an event, such as "branch-misses".
+ */
+[[nodiscard]] std::string_view event_name(Event event);
+
+/**
+ * @brief The count of each event, or nothing for events that could not be counted.
+ */
+using EventCounts = std::array<std::optional<std::uint64_t>, kEventCount>;
+
+/**
+ * @brief Linux @c perf_event_open counters for the calling thread and the threads it starts.
+ *
+ * Each event is opened separately and only in user space,
+ * so that the events the CPU or the kernel's @c perf_event_paranoid setting allow
+ * are still counted when others are not.
+ * Counts are scaled up when the kernel had to multiplex the hardware counters.
+ */
+class EventCounters final {
+    std::array<int, kEventCount> descriptors_{};
+    std::string unavailable_reason_{};
+
+  public:
+    /**
+     * @brief Opens the counters, leaving out the events that cannot be counted.
+     */
+    EventCounters();
+
+    EventCounters(const EventCounters& other) = delete;
+    EventCounters(EventCounters&& other) = delete;
+    EventCounters& operator=(const EventCounters& other) = delete;
+    EventCounters& operator=(EventCounters&& other) = delete;
+
+    ~EventCounters();
+
+    /**
+     * @brief Checks whether an event is being counted.
+     */
+    [[nodiscard]] bool available(Event event) const;
+
+    /**
+     * @brief Describes why some events are not counted, or is empty if all of them are.
+     */
+    [[nodiscard]] const std::string& unavailable_reason() const { return unavailable_reason_; }
+
+    /**
+     * @brief Resets and starts all counters.
+     */
+    void start();
+
+    /**
+     * @brief Stops all counters.
+     *
+     * @return The counts since the last call to @c start.
+     */
+    [[nodiscard]] EventCounts stop();
+};
+
+/**
+ * @brief The wall-clock time and event counts of one phase of a run.
+ */
+struct PhaseStats {
+    /** The name of the phase, such as "parse". */
+    std::string name{};
+    /** The elapsed time in milliseconds. */
+    double wall_ms{};
+    /** The events counted during the phase. */
+    EventCounts counts{};
+    /** The highest resident set size of the process during the phase, in bytes. */
+    std::uint64_t peak_rss_bytes{};
+    /** The highest number of heap bytes in use during the phase, if allocations are tracked. */
+    std::optional<std::uint64_t> peak_heap_bytes{};
+};
+
+/**
+ * @brief Measures the named phases of a run, or only runs them when disabled.
+ *
+ * Besides time and events, each phase records the peak resident set size
+ * and, in builds that track allocations, the peak heap usage.
+ */
+class PhaseRecorder final {
+    bool enabled_{false};
+    std::unique_ptr<EventCounters> counters_{};
+    std::vector<PhaseStats> phases_{};
+
+    /**
+     * @brief Records the phase that is running while it exists, even if the phase throws.
+     */
+    class Scope final {
+        PhaseRecorder& recorder_;
+        std::chrono::steady_clock::time_point start_{};
+
+      public:
+        Scope(PhaseRecorder& recorder, std::string_view name);
+
+        Scope(const Scope& other) = delete;
+        Scope(Scope&& other) = delete;
+        Scope& operator=(const Scope& other) = delete;
+        Scope& operator=(Scope&& other) = delete;
+
+        ~Scope();
+    };
+
+  public:
+    /**
+     * @brief Creates a recorder, opening the event counters if it is enabled.
+     *
+     * @param enabled Whether phases are measured.
+     */
+    explicit PhaseRecorder(bool enabled);
+
+    /**
+     * @brief Runs one phase, measuring it if the recorder is enabled.
+     *
+     * Phases must not be nested.
+     *
+     * @tparam F The type of the function.
+     * @param name The name of the phase.
+     * @param f The function that runs the phase.
+     * @return What @p f returns.
+     */
+    template <typename F>
+    decltype(auto) measure(const std::string_view name, F&& f) {
+        if (!enabled_) return std::forward<F>(f)();
+        const Scope scope{*this, name};
+        return std::forward<F>(f)();
+    }
+
+    /**
+     * @brief Returns the phases measured so far, in order.
+     */
+    [[nodiscard]] const std::vector<PhaseStats>& phases() const { return phases_; }
+
+    /**
+     * @brief Formats the measured phases as a table with one row per phase,
+     *        followed by a note on the events that could not be counted, if any.
+     */
+    [[nodiscard]] std::string format_table() const;
+};
+
+}  // namespace aoc24::perf
+
+#endif  // AOC24_CPP_SRC_PERF_PERF_H_
@@ -0,0 +1,61 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Dataset.h"
+
+#include <algorithm>
+
+#include "../day1/day1.h"
+
+namespace aoc24::server {
+
+Day1Index index_location_lists(std::vector<int> left_list, std::vector<int> right_list) {
+    Day1Index index{};
+    index.pair_count = left_list.size();
+    index.counts.reserve(left_list.size());
+
+    for (const int id : left_list) ++index.counts[id].left;
+    for (const int id : right_list) ++index.counts[id].right;
+    for (const auto& [id, counts] : index.counts)
+        index.similarity_score += std::int64_t{id} * counts.left * counts.right;
+
+    std::sort(left_list.begin(), left_list.end());
+    std::sort(right_list.begin(), right_list.end());
+    index.total_distance = day1::sum_of_distances(left_list, right_list);
+
+    return index;
+}
+
+Day2Index index_reports(const std::vector<day2::Report>& reports) {
+    Day2Index index{day2::ReportTable{reports}};
+    index.safe_count = index.table.count_safe();
+    index.dampened_safe_count = index.table.count_safe_with_problem_dampener();
+    return index;
+}
+
+std::shared_ptr<const Dataset> load_dataset(const std::filesystem::path& location_lists_path,
+                                            const std::filesystem::path& reactor_data_path,
+                                            const std::uint64_t generation) {
+    auto [left_list, right_list]{day1::read_location_lists(location_lists_path)};
+
+    auto dataset{std::make_shared<Dataset>()};
+    dataset->day1 = index_location_lists(std::move(left_list), std::move(right_list));
+    dataset->day2 = index_reports(day2::read_reactor_data(reactor_data_path));
+    dataset->generation = generation;
+    return dataset;
+}
+
+}  // namespace aoc24::server
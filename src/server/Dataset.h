@@ -0,0 +1,152 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_SERVER_DATASET_H_
+#define AOC24_CPP_SRC_SERVER_DATASET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../day2/Report.h"
+#include "../day2/ReportTable.h"
+
+namespace aoc24::server {
+
+/**
+ * @brief How often a location ID occurs in each list.
+ */
+struct LocationCounts {
+    /** The number of occurrences in the left list. */
+    std::int64_t left{};
+    /** The number of occurrences in the right list. */
+    std::int64_t right{};
+};
+
+/**
+ * @brief The day 1 answers and a per-ID index over the location lists.
+ */
+struct Day1Index {
+    /** The number of location ID pairs. */
+    std::size_t pair_count{};
+    /** The sum of the distances between the paired location IDs. */
+    std::int64_t total_distance{};
+    /** The similarity score of the two location lists. */
+    std::int64_t similarity_score{};
+    /** The occurrences of every ID that appears in either list. */
+    std::unordered_map<int, LocationCounts> counts{};
+};
+
+/**
+ * @brief The day 2 reports with their problem dampener outcome precomputed.
+ */
+struct Day2Index {
+    /** The evaluated reports, in input order. */
+    day2::ReportTable table{};
+    /** The number of reports that are safe on their own. */
+    std::size_t safe_count{};
+    /** The number of reports that are safe when using the problem dampener. */
+    std::size_t dampened_safe_count{};
+};
+
+/**
+ * @brief An immutable snapshot of both inputs, indexed for answering queries.
+ */
+struct Dataset {
+    /** The indexed location lists. */
+    Day1Index day1{};
+    /** The indexed reactor reports. */
+    Day2Index day2{};
+    /** Counts the loads, so that clients can tell when a reload has happened. */
+    std::uint64_t generation{};
+};
+
+/**
+ * @brief Indexes a pair of location lists.
+ *
+ * @param left_list The left list of location IDs.
+ * @param right_list The right list of location IDs.
+ * @return The index. The similarity score is computed in 64 bits and does not overflow.
+ */
+[[nodiscard]] Day1Index index_location_lists(std::vector<int> left_list,
+                                             std::vector<int> right_list);
+
+/**
+ * @brief Indexes reactor reports by evaluating the problem dampener on each of them.
+ *
+ * @param reports The reports.
+ * @return The index.
+ * @throw OverflowException If a report is too long to evaluate.
+ */
+[[nodiscard]] Day2Index index_reports(const std::vector<day2::Report>& reports);
+
+/**
+ * @brief Reads, parses and indexes both input files.
+ *
+ * @param location_lists_path The path to the day 1 input.
+ * @param reactor_data_path The path to the day 2 input.
+ * @param generation The generation number of the new snapshot.
+ * @return The snapshot.
+ * @throws FileReadException If either file cannot be opened or read.
+ * @throws ParseException If either file cannot be parsed.
+ * @throw OverflowException If a report is too long to evaluate.
+ */
+[[nodiscard]] std::shared_ptr<const Dataset> load_dataset(
+    const std::filesystem::path& location_lists_path,
+    const std::filesystem::path& reactor_data_path, std::uint64_t generation);
+
+/**
+ * @brief Holds the current snapshot and replaces it atomically.
+ *
+ * Readers keep the snapshot they loaded alive for as long as they use it,
+ * so a reload never invalidates an answer that is being computed.
+ */
+class DatasetHandle final {
+    std::shared_ptr<const Dataset> dataset_{};
+
+  public:
+    /**
+     * @brief Constructs a handle holding an initial snapshot.
+     *
+     * @param dataset The initial snapshot.
+     */
+    explicit DatasetHandle(std::shared_ptr<const Dataset> dataset)
+        : dataset_{std::move(dataset)} {}
+
+    /**
+     * @brief Returns the current snapshot. Safe to call concurrently with @c replace.
+     */
+    [[nodiscard]] std::shared_ptr<const Dataset> current() const {
+        return std::atomic_load(&dataset_);
+    }
+
+    /**
+     * @brief Publishes a new snapshot. Safe to call concurrently with @c current.
+     *
+     * @param dataset The new snapshot.
+     */
+    void replace(std::shared_ptr<const Dataset> dataset) {
+        std::atomic_store(&dataset_, std::move(dataset));
+    }
+};
+
+}  // namespace aoc24::server
+
+#endif  // AOC24_CPP_SRC_SERVER_DATASET_H_
@@ -0,0 +1,497 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "server.h"
+
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifndef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+#endif
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <spdlog/spdlog.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <memory>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "../AocException.h"
+#include "../signals.h"
+
+namespace aoc24::server {
+
+namespace {
+
+/** The longest query line accepted before the connection is dropped. */
+constexpr std::size_t kMaxQueryLength{4096};
+constexpr std::size_t kReadSize{4096};
+/** The most unsent answer bytes a connection may hold before the server stops reading from it. */
+constexpr std::size_t kMaxPendingOutput{std::size_t{1} << 20};
+/** How long a connection may stay over @c kMaxPendingOutput before it is dropped. */
+constexpr std::chrono::seconds kMaxStallDuration{10};
+
+[[nodiscard]] std::string_view next_token(std::string_view& rest) {
+    const auto start{rest.find_first_not_of(' ')};
+    if (start == std::string_view::npos) {
+        rest = {};
+        return {};
+    }
+    rest.remove_prefix(start);
+    const auto end{std::min(rest.find(' '), rest.size())};
+    const auto token{rest.substr(0, end)};
+    rest.remove_prefix(end);
+    return token;
+}
+
+template <typename T>
+[[nodiscard]] std::optional<T> parse_number(const std::string_view token) {
+    T value{};
+    const auto [end, error]{std::from_chars(token.data(), token.data() + token.size(), value)};
+    if (error != std::errc{} || end != token.data() + token.size()) return std::nullopt;
+    return value;
+}
+
+[[nodiscard]] std::string answer_similarity(const Day1Index& index, const std::string_view id) {
+    if (id.empty()) return fmt::format("ok {}", index.similarity_score);
+
+    const auto value{parse_number<int>(id)};
+    if (!value) return fmt::format("error not a location ID: {}", id);
+
+    const auto it{index.counts.find(*value)};
+    if (it == index.counts.end()) return "ok 0 0 0";
+    const auto& counts{it->second};
+    return fmt::format("ok {} {} {}", std::int64_t{*value} * counts.left * counts.right,
+                       counts.left, counts.right);
+}
+
+[[nodiscard]] std::string answer_safe(const Day2Index& index, const std::string_view removals) {
+    if (removals.empty() || removals == "1")
+        return fmt::format("ok {}", index.dampened_safe_count);
+    if (removals == "0") return fmt::format("ok {}", index.safe_count);
+    return fmt::format("error only 0 or 1 removals are supported, got: {}", removals);
+}
+
+[[nodiscard]] std::string answer_report(const Day2Index& index, const std::string_view token) {
+    const auto report_index{parse_number<std::size_t>(token)};
+    if (!report_index) return fmt::format("error not a report index: {}", token);
+    if (*report_index >= index.table.size())
+        return fmt::format("error there are only {} reports", index.table.size());
+
+    return fmt::format("ok levels={} removal={}",
+                       fmt::join(index.table.report(*report_index).levels(), ","),
+                       day2::dampener_removal_name(index.table.removal(*report_index)));
+}
+
+/**
+ * @brief The size and modification time of a file, used to notice changes.
+ */
+struct FileStamp {
+    std::filesystem::file_time_type modified{};
+    std::uintmax_t size{};
+
+    bool operator==(const FileStamp& other) const {
+        return modified == other.modified && size == other.size;
+    }
+    bool operator!=(const FileStamp& other) const { return !(*this == other); }
+};
+
+[[nodiscard]] FileStamp stamp_of(const std::filesystem::path& file_path) {
+    // A file that cannot be inspected gets an empty stamp; the reload then reports the error.
+    std::error_code error{};
+    FileStamp stamp{};
+    stamp.modified = std::filesystem::last_write_time(file_path, error);
+    stamp.size = std::filesystem::file_size(file_path, error);
+    return stamp;
+}
+
+/**
+ * @brief Reloads the inputs in the background and publishes each new snapshot.
+ */
+class Reloader final {
+    const ServerConfig& config_;
+    DatasetHandle& handle_;
+    std::uint64_t generation_{1};
+    std::pair<FileStamp, FileStamp> stamps_{};
+    std::future<std::shared_ptr<const Dataset>> pending_{};
+    std::chrono::steady_clock::time_point last_check_{std::chrono::steady_clock::now()};
+    bool forced_{false};
+
+    [[nodiscard]] std::pair<FileStamp, FileStamp> current_stamps() const {
+        return {stamp_of(config_.location_lists_path), stamp_of(config_.reactor_data_path)};
+    }
+
+  public:
+    Reloader(const ServerConfig& config, DatasetHandle& handle)
+        : config_{config}, handle_{handle}, stamps_{current_stamps()} {}
+
+    Reloader(const Reloader& other) = delete;
+    Reloader(Reloader&& other) = delete;
+    Reloader& operator=(const Reloader& other) = delete;
+    Reloader& operator=(Reloader&& other) = delete;
+
+    ~Reloader() {
+        if (pending_.valid()) pending_.wait();
+    }
+
+    void request() { forced_ = true; }
+
+    /**
+     * @brief Publishes a finished reload and starts a new one if the inputs changed.
+     */
+    void poll() {
+        if (pending_.valid()) {
+            if (pending_.wait_for(std::chrono::seconds{0}) != std::future_status::ready) return;
+            try {
+                auto dataset{pending_.get()};
+                SPDLOG_INFO("Loaded generation {}: {} location pairs and {} reports.",
+                            dataset->generation, dataset->day1.pair_count,
+                            dataset->day2.table.size());
+                handle_.replace(std::move(dataset));
+            } catch (const AocException& error) {
+                SPDLOG_ERROR("Reload failed, keeping the previous data: {}",
+                             error.error_message());
+            } catch (const std::exception& error) {
+                // Anything else thrown on the reload thread, like running out of memory
+                // or a filesystem error, must not stop a server that still has valid data.
+                SPDLOG_ERROR("Reload failed, keeping the previous data: {}", error.what());
+            }
+        }
+
+        const auto now{std::chrono::steady_clock::now()};
+        if (!forced_ && now - last_check_ < config_.reload_check_interval) return;
+        last_check_ = now;
+
+        const auto stamps{current_stamps()};
+        if (!forced_ && stamps.first == stamps_.first && stamps.second == stamps_.second) return;
+
+        // Remember the stamps even if the reload fails, so that a broken file is only retried
+        // once it changes again.
+        stamps_ = stamps;
+        forced_ = false;
+        pending_ = std::async(std::launch::async, load_dataset, config_.location_lists_path,
+                              config_.reactor_data_path, ++generation_);
+    }
+};
+
+/**
+ * @brief A non-blocking listening socket that removes its socket file on destruction.
+ */
+class ListeningSocket final {
+    int fd_{-1};
+    ServerAddress address_{};
+
+    [[noreturn]] void fail(const std::string_view operation) const {
+        const auto error{errno};
+        throw SocketException{operation, to_string(address_), error};
+    }
+
+    void bind_unix_socket() {
+        sockaddr_un socket_address{};
+        socket_address.sun_family = AF_UNIX;
+        const auto& path{address_.path.native()};
+        if (path.size() >= sizeof(socket_address.sun_path)) {
+            errno = ENAMETOOLONG;
+            fail("bind");
+        }
+        std::memcpy(socket_address.sun_path, path.c_str(), path.size() + 1);
+
+        // Replace a socket file left behind by a previous run, but nothing else.
+        std::error_code error{};
+        if (std::filesystem::is_socket(address_.path, error))
+            std::filesystem::remove(address_.path, error);
+
+        if (::bind(fd_, reinterpret_cast<const sockaddr*>(&socket_address),
+                   sizeof(socket_address)) != 0)
+            fail("bind");
+    }
+
+    void bind_tcp_socket() {
+        const int enable{1};
+        setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+        sockaddr_in socket_address{};
+        socket_address.sin_family = AF_INET;
+        socket_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socket_address.sin_port = htons(address_.port);
+        if (::bind(fd_, reinterpret_cast<const sockaddr*>(&socket_address),
+                   sizeof(socket_address)) != 0)
+            fail("bind");
+
+        socklen_t length{sizeof(socket_address)};
+        if (getsockname(fd_, reinterpret_cast<sockaddr*>(&socket_address), &length) == 0)
+            address_.port = ntohs(socket_address.sin_port);
+    }
+
+  public:
+    explicit ListeningSocket(const ServerAddress& address) : address_{address} {
+        const auto domain{address_.kind == ServerAddress::Kind::tcp ? AF_INET : AF_UNIX};
+        fd_ = socket(domain, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd_ < 0) fail("create");
+
+        try {
+            if (address_.kind == ServerAddress::Kind::tcp)
+                bind_tcp_socket();
+            else
+                bind_unix_socket();
+            if (listen(fd_, SOMAXCONN) != 0) fail("listen on");
+        } catch (...) {
+            close(fd_);
+            throw;
+        }
+    }
+
+    ListeningSocket(const ListeningSocket& other) = delete;
+    ListeningSocket(ListeningSocket&& other) = delete;
+    ListeningSocket& operator=(const ListeningSocket& other) = delete;
+    ListeningSocket& operator=(ListeningSocket&& other) = delete;
+
+    ~ListeningSocket() {
+        close(fd_);
+        if (address_.kind == ServerAddress::Kind::unix_socket) {
+            std::error_code error{};
+            std::filesystem::remove(address_.path, error);
+        }
+    }
+
+    [[nodiscard]] int fd() const { return fd_; }
+
+    /**
+     * @brief The bound address, with the actual port if the system picked one.
+     */
+    [[nodiscard]] const ServerAddress& address() const { return address_; }
+};
+
+/**
+ * @brief A client connection with its partial input line and unsent output.
+ */
+struct Connection {
+    int fd{-1};
+    std::string input{};
+    std::string output{};
+    bool closing{false};
+    /** When the output last went over @c kMaxPendingOutput, if it still is. */
+    std::optional<std::chrono::steady_clock::time_point> stalled_since{};
+
+    [[nodiscard]] bool output_full() const { return output.size() >= kMaxPendingOutput; }
+};
+
+/**
+ * @brief Sends as much buffered output as the socket accepts.
+ *
+ * @return False if the connection failed.
+ */
+[[nodiscard]] bool flush_output(Connection& connection) {
+    while (!connection.output.empty()) {
+        const auto sent{send(connection.fd, connection.output.data(), connection.output.size(),
+                             MSG_NOSIGNAL)};
+        if (sent < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        connection.output.erase(0, static_cast<std::size_t>(sent));
+    }
+    return true;
+}
+
+/**
+ * @brief Answers every complete query line received on a connection.
+ */
+void handle_queries(Connection& connection, const DatasetHandle& handle, Reloader& reloader) {
+    std::size_t line_start{0};
+    for (auto line_end{connection.input.find('\n')}; line_end != std::string::npos;
+         line_end = connection.input.find('\n', line_start)) {
+        std::string_view query{connection.input.data() + line_start, line_end - line_start};
+        line_start = line_end + 1;
+        if (!query.empty() && query.back() == '\r') query.remove_suffix(1);
+
+        if (query == "quit") {
+            connection.closing = true;
+            break;
+        }
+        if (query == "reload") {
+            reloader.request();
+            connection.output += "ok reload scheduled\n";
+            continue;
+        }
+
+        connection.output += answer_query(*handle.current(), query);
+        connection.output += '\n';
+    }
+    connection.input.erase(0, line_start);
+
+    if (connection.input.size() > kMaxQueryLength) {
+        connection.output += "error query too long\n";
+        connection.closing = true;
+    }
+}
+
+/**
+ * @brief Reads from a connection and answers its queries.
+ *
+ * @return False if the connection should be closed.
+ */
+[[nodiscard]] bool serve_connection(Connection& connection, const DatasetHandle& handle,
+                                    Reloader& reloader) {
+    char buffer[kReadSize];
+    // Stop reading once the answers pile up, so that a client that does not read them
+    // cannot make the output grow without bound.
+    while (!connection.closing && !connection.output_full()) {
+        const auto received{recv(connection.fd, buffer, sizeof(buffer), 0)};
+        if (received == 0) return false;
+        if (received < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            if (errno == EINTR) continue;
+            return false;
+        }
+        connection.input.append(buffer, static_cast<std::size_t>(received));
+        handle_queries(connection, handle, reloader);
+    }
+    return flush_output(connection);
+}
+
+void accept_connections(const ListeningSocket& listener, std::vector<Connection>& connections) {
+    while (true) {
+        const int fd{accept4(listener.fd(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)};
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                SPDLOG_WARN("Failed to accept a connection: {}", std::strerror(errno));
+            return;
+        }
+        connections.push_back(Connection{fd});
+        SPDLOG_DEBUG("Accepted connection {}.", fd);
+    }
+}
+
+}  // namespace
+
+std::optional<ServerAddress> parse_server_address(const std::string_view address) {
+    constexpr std::string_view kUnixPrefix{"unix:"};
+    constexpr std::string_view kTcpPrefix{"tcp:"};
+
+    if (address.substr(0, kUnixPrefix.size()) == kUnixPrefix) {
+        const auto path{address.substr(kUnixPrefix.size())};
+        if (path.empty()) return std::nullopt;
+        return ServerAddress{ServerAddress::Kind::unix_socket, std::filesystem::path{path}, 0};
+    }
+
+    if (address.substr(0, kTcpPrefix.size()) == kTcpPrefix) {
+        const auto port{parse_number<std::uint16_t>(address.substr(kTcpPrefix.size()))};
+        if (!port) return std::nullopt;
+        return ServerAddress{ServerAddress::Kind::tcp, {}, *port};
+    }
+
+    return std::nullopt;
+}
+
+std::string to_string(const ServerAddress& address) {
+    if (address.kind == ServerAddress::Kind::tcp) return "tcp:" + std::to_string(address.port);
+    return "unix:" + address.path.string();
+}
+
+std::string answer_query(const Dataset& dataset, std::string_view query) {
+    const auto command{next_token(query)};
+    const auto argument{next_token(query)};
+    if (!next_token(query).empty()) return "error too many arguments";
+
+    if (command == "similarity") return answer_similarity(dataset.day1, argument);
+    if (command == "safe") return answer_safe(dataset.day2, argument);
+    if (command == "report") return answer_report(dataset.day2, argument);
+
+    if (command != "distance" && command != "info")
+        return fmt::format("error unknown query: {}", command);
+    if (!argument.empty()) return fmt::format("error {} takes no argument", command);
+    if (command == "distance") return fmt::format("ok {}", dataset.day1.total_distance);
+    return fmt::format("ok pairs={} reports={} generation={}", dataset.day1.pair_count,
+                       dataset.day2.table.size(), dataset.generation);
+}
+
+void serve(const ServerConfig& config) {
+    DatasetHandle handle{load_dataset(config.location_lists_path, config.reactor_data_path, 1)};
+    Reloader reloader{config, handle};
+    const ListeningSocket listener{config.address};
+    signals::install_stop_handlers();
+    SPDLOG_INFO("Listening on {}.", to_string(listener.address()));
+
+    std::vector<Connection> connections{};
+    std::vector<pollfd> poll_fds{};
+    const auto timeout{static_cast<int>(config.reload_check_interval.count())};
+
+    while (!signals::stop_requested()) {
+        poll_fds.clear();
+        poll_fds.push_back(pollfd{listener.fd(), POLLIN, 0});
+        for (const auto& connection : connections) {
+            const short events = connection.output.empty() ? POLLIN
+                                 : connection.output_full() ? POLLOUT
+                                                            : POLLIN | POLLOUT;
+            poll_fds.push_back(pollfd{connection.fd, events, 0});
+        }
+
+        if (::poll(poll_fds.data(), poll_fds.size(), timeout) < 0 && errno != EINTR)
+            throw SocketException{"poll", to_string(listener.address()), errno};
+        reloader.poll();
+
+        // Serve the existing connections first, since accepting may grow the vector.
+        for (std::size_t i{0}; i < connections.size(); ++i) {
+            auto& connection{connections[i]};
+            const auto revents{poll_fds[i + 1].revents};
+            bool keep{true};
+            if (revents & (POLLIN | POLLHUP | POLLERR))
+                keep = serve_connection(connection, handle, reloader);
+            else if (revents & POLLOUT)
+                keep = flush_output(connection);
+
+            if (!connection.output_full()) {
+                connection.stalled_since.reset();
+            } else if (!connection.stalled_since) {
+                connection.stalled_since = std::chrono::steady_clock::now();
+            } else if (std::chrono::steady_clock::now() - *connection.stalled_since >
+                       kMaxStallDuration) {
+                SPDLOG_WARN("Dropping connection {}, which has not read its answers.",
+                            connection.fd);
+                keep = false;
+            }
+
+            if (!keep || (connection.closing && connection.output.empty())) {
+                SPDLOG_DEBUG("Closing connection {}.", connection.fd);
+                close(connection.fd);
+                connection.fd = -1;
+            }
+        }
+        connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                         [](const Connection& c) { return c.fd < 0; }),
+                          connections.end());
+
+        if (poll_fds[0].revents & POLLIN) accept_connections(listener, connections);
+    }
+
+    SPDLOG_INFO("Shutting down.");
+    for (const auto& connection : connections) close(connection.fd);
+}
+
+}  // namespace aoc24::server
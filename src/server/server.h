@@ -0,0 +1,122 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_SERVER_SERVER_H_
+#define AOC24_CPP_SRC_SERVER_SERVER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "../day1/day1.h"
+#include "../day2/day2.h"
+#include "Dataset.h"
+
+namespace aoc24::server {
+
+/**
+ * @brief Where the query server listens.
+ */
+struct ServerAddress {
+    /**
+     * @brief The kind of socket.
+     */
+    enum class Kind : std::uint8_t {
+        /** A Unix domain socket at @c path. */
+        unix_socket,
+        /** A TCP socket on the loopback interface at @c port. */
+        tcp,
+    };
+
+    /** The kind of socket. */
+    Kind kind{Kind::unix_socket};
+    /** The socket file of a Unix domain socket. */
+    std::filesystem::path path{};
+    /** The port of a TCP socket, or zero to let the system pick one. */
+    std::uint16_t port{};
+};
+
+/**
+ * @brief Parses a server address of the form @c unix:PATH or @c tcp:PORT.
+ *
+ * @param address The address to parse.
+ * @return The address, or an empty optional if it is malformed.
+ */
+[[nodiscard]] std::optional<ServerAddress> parse_server_address(std::string_view address);
+
+/**
+ * @brief Formats a server address the way @c parse_server_address accepts it.
+ *
+ * @param address The address to format.
+ * @return The formatted address.
+ */
+[[nodiscard]] std::string to_string(const ServerAddress& address);
+
+/**
+ * @brief The settings of the query server.
+ */
+struct ServerConfig {
+    /** Where to listen. */
+    ServerAddress address{};
+    /** The day 1 input. */
+    std::filesystem::path location_lists_path{day1::kLocationListsFilePath};
+    /** The day 2 input. */
+    std::filesystem::path reactor_data_path{day2::kReactorDataFilePath};
+    /** How often the inputs are checked for changes. */
+    std::chrono::milliseconds reload_check_interval{250};
+};
+
+/**
+ * @brief Answers one query against a snapshot.
+ *
+ * The protocol is line based. Every answer is a single line starting with @c ok or @c error.
+ * The supported queries are:
+ * - @c distance: the total distance between the location lists.
+ * - @c similarity: the similarity score of the location lists.
+ * - @c similarity ID: the contribution of one ID to the similarity score,
+ *   followed by its number of occurrences in the left and right list.
+ * - @c safe [REMOVALS]: the number of safe reports when up to @c REMOVALS levels may be removed.
+ *   Only 0 and 1 (the default, the problem dampener) are supported.
+ * - @c report INDEX: the levels of a report and which removal made it safe.
+ * - @c info: the size and generation of the snapshot.
+ *
+ * @param dataset The snapshot to answer from.
+ * @param query The query, without its line terminator.
+ * @return The answer, without a line terminator.
+ */
+[[nodiscard]] std::string answer_query(const Dataset& dataset, std::string_view query);
+
+/**
+ * @brief Loads the inputs and answers queries until interrupted by @c SIGINT or @c SIGTERM.
+ *
+ * Besides the queries handled by @c answer_query, clients can send @c reload to force a reload
+ * and @c quit to close their connection. The inputs are reloaded in the background whenever
+ * their size or modification time changes, and the new snapshot replaces the old one atomically.
+ * A reload that fails is logged, and the previous snapshot stays in use.
+ *
+ * @param config The server settings.
+ * @throws FileReadException If an input cannot be read on startup.
+ * @throws ParseException If an input cannot be parsed on startup.
+ * @throws SocketException If the socket cannot be set up.
+ */
+void serve(const ServerConfig& config);
+
+}  // namespace aoc24::server
+
+#endif  // AOC24_CPP_SRC_SERVER_SERVER_H_
@@ -0,0 +1,312 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "shard.h"
+
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifndef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+#endif
+
+#include <spawn.h>
+#include <spdlog/spdlog.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../AocException.h"
+#include "../day1/day1.h"
+#include "../day1/sorted_runs.h"
+#include "../day2/day2.h"
+#include "../utils.h"
+
+extern char** environ;
+
+namespace aoc24::shard {
+
+namespace {
+
+constexpr std::string_view kPartialMagic{"aoc24-partial"};
+constexpr int kPartialVersion{1};
+
+/**
+ * @brief Reads the expected keyword followed by a value from a partial result file.
+ */
+template <typename T>
+void read_field(std::istream& stream, const std::string_view key, T& value,
+                const std::filesystem::path& file_path) {
+    std::string actual_key{};
+    if (!(stream >> actual_key >> value) || actual_key != key)
+        throw ParseException{"Malformed partial result " + file_path.string() + ": expected " +
+                             std::string{key}};
+}
+
+void read_header(std::istream& stream, const int day, const std::filesystem::path& file_path) {
+    int version{};
+    int actual_day{};
+    read_field(stream, kPartialMagic, version, file_path);
+    read_field(stream, "day", actual_day, file_path);
+    if (version != kPartialVersion || actual_day != day)
+        throw ParseException{"Partial result " + file_path.string() + " is not a version " +
+                             std::to_string(kPartialVersion) + " day " + std::to_string(day) +
+                             " result"};
+}
+
+[[nodiscard]] std::ofstream open_for_writing(const std::filesystem::path& file_path) {
+    std::ofstream file{file_path};
+    if (!file.is_open()) throw FileWriteException{file_path, errno};
+    return file;
+}
+
+void finish_writing(std::ofstream& file, const std::filesystem::path& file_path) {
+    file.flush();
+    if (!file) throw FileWriteException{file_path, errno};
+}
+
+[[nodiscard]] std::ifstream open_for_reading(const std::filesystem::path& file_path) {
+    std::ifstream file{file_path};
+    if (!file.is_open()) throw FileReadException{file_path, errno};
+    return file;
+}
+
+[[nodiscard]] std::string describe_exit_status(const int status) {
+    if (WIFEXITED(status)) return "exited with code " + std::to_string(WEXITSTATUS(status));
+    if (WIFSIGNALED(status)) return "was killed by signal " + std::to_string(WTERMSIG(status));
+    return "stopped with status " + std::to_string(status);
+}
+
+}  // namespace
+
+std::vector<ByteRange> split_file(const std::filesystem::path& file_path,
+                                  const std::size_t shard_count) {
+    std::error_code error{};
+    const auto file_size{std::filesystem::file_size(file_path, error)};
+    if (error) throw FileReadException{file_path, error.value()};
+
+    const auto count{std::max<std::uintmax_t>(1, shard_count)};
+    std::vector<ByteRange> ranges{};
+    ranges.reserve(count);
+    for (std::uintmax_t i{0}; i < count; ++i)
+        ranges.push_back({file_size * i / count, file_size * (i + 1) / count});
+    return ranges;
+}
+
+Day1Partial compute_day1_partial(const std::filesystem::path& input_path, const ByteRange range,
+                                 const std::filesystem::path& run_prefix) {
+    const auto contents{utils::read_file_line_range(input_path, range.start, range.end)};
+    auto [left_list, right_list]{
+        day1::try_parse_location_lists(contents, input_path).value_or_throw()};
+
+    std::sort(left_list.begin(), left_list.end());
+    std::sort(right_list.begin(), right_list.end());
+
+    Day1Partial partial{};
+    partial.pair_count = std::min(left_list.size(), right_list.size());
+    partial.left_run = run_prefix.string() + ".left";
+    partial.right_run = run_prefix.string() + ".right";
+    day1::write_sorted_run(partial.left_run, left_list);
+    day1::write_sorted_run(partial.right_run, right_list);
+
+    for (const int right_val : right_list) {
+        if (partial.right_histogram.empty() || partial.right_histogram.back().first != right_val)
+            partial.right_histogram.emplace_back(right_val, 0);
+        ++partial.right_histogram.back().second;
+    }
+
+    return partial;
+}
+
+Day2Partial compute_day2_partial(const std::filesystem::path& input_path, const ByteRange range) {
+    const auto contents{utils::read_file_line_range(input_path, range.start, range.end)};
+    const auto reports{day2::try_parse_reactor_data(contents).value_or_throw()};
+
+    Day2Partial partial{};
+    partial.report_count = reports.size();
+    partial.safe_count = static_cast<std::uint64_t>(day2::count_safe_reports(reports));
+    partial.dampened_safe_count =
+        static_cast<std::uint64_t>(day2::count_safe_reports_with_problem_dampener(reports));
+    return partial;
+}
+
+void write_partial(const std::filesystem::path& file_path, const Day1Partial& partial) {
+    auto file{open_for_writing(file_path)};
+    file << kPartialMagic << ' ' << kPartialVersion << "\nday 1\n"
+         << "pairs " << partial.pair_count << '\n'
+         << "left-run " << partial.left_run << '\n'
+         << "right-run " << partial.right_run << '\n'
+         << "histogram " << partial.right_histogram.size() << '\n';
+    for (const auto& [value, count] : partial.right_histogram) file << value << ' ' << count << '\n';
+    finish_writing(file, file_path);
+}
+
+void write_partial(const std::filesystem::path& file_path, const Day2Partial& partial) {
+    auto file{open_for_writing(file_path)};
+    file << kPartialMagic << ' ' << kPartialVersion << "\nday 2\n"
+         << "reports " << partial.report_count << '\n'
+         << "safe " << partial.safe_count << '\n'
+         << "dampened-safe " << partial.dampened_safe_count << '\n';
+    finish_writing(file, file_path);
+}
+
+Day1Partial read_day1_partial(const std::filesystem::path& file_path) {
+    auto file{open_for_reading(file_path)};
+    read_header(file, 1, file_path);
+
+    Day1Partial partial{};
+    std::size_t histogram_size{};
+    read_field(file, "pairs", partial.pair_count, file_path);
+    read_field(file, "left-run", partial.left_run, file_path);
+    read_field(file, "right-run", partial.right_run, file_path);
+    read_field(file, "histogram", histogram_size, file_path);
+
+    partial.right_histogram.resize(histogram_size);
+    for (auto& [value, count] : partial.right_histogram) {
+        if (!(file >> value >> count))
+            throw ParseException{"Malformed partial result " + file_path.string() +
+                                 ": truncated histogram"};
+    }
+
+    return partial;
+}
+
+Day2Partial read_day2_partial(const std::filesystem::path& file_path) {
+    auto file{open_for_reading(file_path)};
+    read_header(file, 2, file_path);
+
+    Day2Partial partial{};
+    read_field(file, "reports", partial.report_count, file_path);
+    read_field(file, "safe", partial.safe_count, file_path);
+    read_field(file, "dampened-safe", partial.dampened_safe_count, file_path);
+    return partial;
+}
+
+Day1Totals merge_partials(const std::vector<Day1Partial>& partials) {
+    std::vector<std::filesystem::path> left_runs{};
+    std::vector<std::filesystem::path> right_runs{};
+    std::vector<std::pair<int, std::uint64_t>> right_histogram{};
+
+    for (const auto& partial : partials) {
+        left_runs.push_back(partial.left_run);
+        right_runs.push_back(partial.right_run);
+        right_histogram.insert(right_histogram.end(), partial.right_histogram.begin(),
+                               partial.right_histogram.end());
+    }
+
+    // Combine the counts of IDs that occur in several shards.
+    std::sort(right_histogram.begin(), right_histogram.end());
+    std::vector<std::pair<int, std::uint64_t>> merged_histogram{};
+    for (const auto& [value, count] : right_histogram) {
+        if (merged_histogram.empty() || merged_histogram.back().first != value)
+            merged_histogram.emplace_back(value, 0);
+        merged_histogram.back().second += count;
+    }
+
+    Day1Totals totals{};
+    totals.total_distance = day1::merge_total_distance(left_runs, right_runs);
+
+    // Join the sorted left IDs against the sorted histogram.
+    day1::RunMerger left{left_runs};
+    auto histogram_it{merged_histogram.cbegin()};
+    for (int left_val{}; left.next(left_val);) {
+        while (histogram_it != merged_histogram.cend() && histogram_it->first < left_val)
+            ++histogram_it;
+        if (histogram_it == merged_histogram.cend()) break;
+        if (histogram_it->first == left_val)
+            totals.similarity_score +=
+                std::int64_t{left_val} * static_cast<std::int64_t>(histogram_it->second);
+    }
+
+    return totals;
+}
+
+Day2Partial merge_partials(const std::vector<Day2Partial>& partials) {
+    Day2Partial merged{};
+    for (const auto& partial : partials) {
+        merged.report_count += partial.report_count;
+        merged.safe_count += partial.safe_count;
+        merged.dampened_safe_count += partial.dampened_safe_count;
+    }
+    return merged;
+}
+
+std::vector<std::filesystem::path> run_local_workers(const std::filesystem::path& executable,
+                                                     const int day,
+                                                     const std::filesystem::path& input_path,
+                                                     const std::size_t shard_count,
+                                                     const std::filesystem::path& work_dir) {
+    const auto ranges{split_file(input_path, shard_count)};
+    std::vector<std::filesystem::path> partial_paths{};
+    std::vector<pid_t> workers{};
+
+    for (std::size_t i{0}; i < ranges.size(); ++i) {
+        partial_paths.push_back(work_dir / ("shard-" + std::to_string(i) + ".partial"));
+
+        const std::vector<std::string> arguments{executable.string(),
+                                                 "--day",
+                                                 std::to_string(day),
+                                                 "--input",
+                                                 input_path.string(),
+                                                 "--shard-range",
+                                                 std::to_string(ranges[i].start),
+                                                 std::to_string(ranges[i].end),
+                                                 "--partial",
+                                                 partial_paths.back().string()};
+        std::vector<char*> argv{};
+        for (const auto& argument : arguments) argv.push_back(const_cast<char*>(argument.c_str()));
+        argv.push_back(nullptr);
+
+        pid_t pid{};
+        const auto error{
+            posix_spawn(&pid, executable.c_str(), nullptr, nullptr, argv.data(), environ)};
+        if (error != 0) {
+            // Don't leave the workers that did start behind.
+            for (const auto worker : workers) waitpid(worker, nullptr, 0);
+            throw WorkerException{"Failed to start worker " + std::to_string(i) + ": " +
+                                  std::strerror(error)};
+        }
+
+        SPDLOG_DEBUG("Started worker {} (pid {}) for bytes [{}, {}).", i, pid, ranges[i].start,
+                     ranges[i].end);
+        workers.push_back(pid);
+    }
+
+    std::string failures{};
+    for (std::size_t i{0}; i < workers.size(); ++i) {
+        int status{};
+        if (waitpid(workers[i], &status, 0) == -1) {
+            failures += " worker " + std::to_string(i) + " could not be waited for;";
+        } else if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failures += " worker " + std::to_string(i) + ' ' + describe_exit_status(status) + ';';
+        }
+    }
+
+    if (!failures.empty()) throw WorkerException{"Workers failed:" + failures};
+    return partial_paths;
+}
+
+}  // namespace aoc24::shard
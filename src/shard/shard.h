@@ -0,0 +1,192 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_SHARD_SHARD_H_
+#define AOC24_CPP_SRC_SHARD_SHARD_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+namespace aoc24::shard {
+
+/**
+ * @brief A half-open range of bytes @c [start, end) in an input file.
+ */
+struct ByteRange {
+    /** The offset of the first byte in the range. */
+    std::uintmax_t start{};
+    /** The offset one past the last byte in the range. */
+    std::uintmax_t end{};
+};
+
+/**
+ * @brief The mergeable result of processing one shard of day 1 input.
+ */
+struct Day1Partial {
+    /** The number of location ID pairs in the shard. */
+    std::uint64_t pair_count{};
+    /** The run file holding the sorted left IDs of the shard. */
+    std::filesystem::path left_run{};
+    /** The run file holding the sorted right IDs of the shard. */
+    std::filesystem::path right_run{};
+    /** How often each right ID occurs in the shard, ordered by ID. */
+    std::vector<std::pair<int, std::uint64_t>> right_histogram{};
+};
+
+/**
+ * @brief The mergeable result of processing one or more shards of day 2 input.
+ */
+struct Day2Partial {
+    /** The number of reports. */
+    std::uint64_t report_count{};
+    /** The number of reports that are safe on their own. */
+    std::uint64_t safe_count{};
+    /** The number of reports that are safe when using the problem dampener. */
+    std::uint64_t dampened_safe_count{};
+};
+
+/**
+ * @brief The final day 1 answers computed from all partial results.
+ */
+struct Day1Totals {
+    /** The sum of the distances between the paired location IDs. */
+    std::int64_t total_distance{};
+    /** The similarity score of the two location lists. */
+    std::int64_t similarity_score{};
+};
+
+/**
+ * @brief Splits a file into byte ranges of roughly equal size.
+ *
+ * @param file_path The path to the file.
+ * @param shard_count The number of ranges to create.
+ * @return Adjacent ranges that together cover the whole file.
+ * @throws FileReadException If the size of the file cannot be determined.
+ */
+[[nodiscard]] std::vector<ByteRange> split_file(const std::filesystem::path& file_path,
+                                                std::size_t shard_count);
+
+/**
+ * @brief Processes the lines of a day 1 input file that start within a byte range.
+ *
+ * @param input_path The path to the location lists.
+ * @param range The byte range to process.
+ * @param run_prefix The path prefix for the run files, which get ".left" and ".right" appended.
+ * @return The partial result.
+ * @throws FileReadException If the input cannot be read.
+ * @throws FileWriteException If the run files cannot be written.
+ * @throws ParseException If the input cannot be parsed.
+ */
+[[nodiscard]] Day1Partial compute_day1_partial(const std::filesystem::path& input_path,
+                                               ByteRange range,
+                                               const std::filesystem::path& run_prefix);
+
+/**
+ * @brief Processes the lines of a day 2 input file that start within a byte range.
+ *
+ * @param input_path The path to the reactor data.
+ * @param range The byte range to process.
+ * @return The partial result.
+ * @throws FileReadException If the input cannot be read.
+ * @throws ParseException If the input cannot be parsed.
+ */
+[[nodiscard]] Day2Partial compute_day2_partial(const std::filesystem::path& input_path,
+                                               ByteRange range);
+
+/**
+ * @brief Writes a day 1 partial result to a file.
+ *
+ * @param file_path The path of the file to create.
+ * @param partial The partial result.
+ * @throws FileWriteException If the file cannot be written.
+ */
+void write_partial(const std::filesystem::path& file_path, const Day1Partial& partial);
+
+/**
+ * @brief Writes a day 2 partial result to a file.
+ *
+ * @param file_path The path of the file to create.
+ * @param partial The partial result.
+ * @throws FileWriteException If the file cannot be written.
+ */
+void write_partial(const std::filesystem::path& file_path, const Day2Partial& partial);
+
+/**
+ * @brief Reads a day 1 partial result written by @c write_partial.
+ *
+ * @param file_path The path of the file.
+ * @return The partial result.
+ * @throws FileReadException If the file cannot be read.
+ * @throws ParseException If the file is not a day 1 partial result.
+ */
+[[nodiscard]] Day1Partial read_day1_partial(const std::filesystem::path& file_path);
+
+/**
+ * @brief Reads a day 2 partial result written by @c write_partial.
+ *
+ * @param file_path The path of the file.
+ * @return The partial result.
+ * @throws FileReadException If the file cannot be read.
+ * @throws ParseException If the file is not a day 2 partial result.
+ */
+[[nodiscard]] Day2Partial read_day2_partial(const std::filesystem::path& file_path);
+
+/**
+ * @brief Combines day 1 partial results into the final answers.
+ *
+ * The sorted runs are merged in lockstep for the distance,
+ * and the left runs are joined against the merged right histogram for the similarity score.
+ *
+ * @param partials The partial results of all shards.
+ * @return The final answers.
+ * @throws FileReadException If a run file cannot be read.
+ */
+[[nodiscard]] Day1Totals merge_partials(const std::vector<Day1Partial>& partials);
+
+/**
+ * @brief Combines day 2 partial results.
+ *
+ * @param partials The partial results of all shards.
+ * @return The sum of the partial results.
+ */
+[[nodiscard]] Day2Partial merge_partials(const std::vector<Day2Partial>& partials);
+
+/**
+ * @brief Runs a worker process for every shard of an input file and waits for them.
+ *
+ * Each worker is started as
+ * `<executable> --day <day> --input <input> --shard-range <start> <end> --partial <file>`
+ * and writes its partial result to a file in @p work_dir.
+ *
+ * @param executable The path of the worker executable.
+ * @param day The puzzle day, 1 or 2.
+ * @param input_path The path to the input file.
+ * @param shard_count The number of workers to run.
+ * @param work_dir The directory for partial results and run files.
+ * @return The paths of the partial result files, in shard order.
+ * @throws FileReadException If the size of the input cannot be determined.
+ * @throws WorkerException If a worker cannot be started or fails.
+ */
+[[nodiscard]] std::vector<std::filesystem::path> run_local_workers(
+    const std::filesystem::path& executable, int day, const std::filesystem::path& input_path,
+    std::size_t shard_count, const std::filesystem::path& work_dir);
+
+}  // namespace aoc24::shard
+
+#endif  // AOC24_CPP_SRC_SHARD_SHARD_H_
@@ -0,0 +1,37 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_SIGNALS_H_
+#define AOC24_CPP_SRC_SIGNALS_H_
+
+namespace aoc24::signals {
+
+/**
+ * @brief Makes @c SIGINT and @c SIGTERM request a graceful stop instead of terminating.
+ *
+ * The handlers are installed without @c SA_RESTART,
+ * so a blocking @c poll returns with @c EINTR when a stop is requested.
+ */
+void install_stop_handlers();
+
+/**
+ * @brief Checks whether @c SIGINT or @c SIGTERM was received since the handlers were installed.
+ */
+[[nodiscard]] bool stop_requested();
+
+}  // namespace aoc24::signals
+
+#endif  // AOC24_CPP_SRC_SIGNALS_H_
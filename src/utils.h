@@ -17,79 +17,221 @@
 #ifndef AOC24_CPP_SRC_UTILS_H_
 #define AOC24_CPP_SRC_UTILS_H_
 
+#include <algorithm>
 #include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <filesystem>
-#include <fstream>
-#include <functional>
-#include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <vector>
 
 #include "AocException.h"
+#include "Expected.h"
 
 namespace aoc24::utils {
 
 /**
  * The directory where the input files are stored.
+ *
+ * The default paths are plain strings rather than @c std::filesystem::path objects,
+ * so that they need no construction at startup in every translation unit that includes them.
  */
-const std::filesystem::path kInputDir{"input"};
+inline constexpr std::string_view kInputDir{"input"};
 
 /**
- * @brief Reads a file line by line and parses each line using the provided parser.
+ * @brief Reads the entire content of a file into a string without throwing on failure.
  *
- * @tparam T The type of the parsed output elements.
  * @param file_path The path to the file to be read.
- * @param line_parser A function to parse an individual line of the file to a type T.
- * @return A vector of parsed elements with type T.
- * @throw FileReadException If the file could not be opened.
+ * @return The content of the file, or an @c ErrorCode::file_read error.
  */
-template <typename T>
-std::vector<T> read_input_lines(const std::filesystem::path& file_path,
-                                const std::function<T(const std::string&)>& line_parser) {
-    std::ifstream file{file_path};
-    if (!file.is_open()) throw FileReadException{file_path, errno};
-    std::vector<T> parsed_lines{};
-    for (std::string line{}; std::getline(file, line);) parsed_lines.push_back(line_parser(line));
-    return parsed_lines;
+inline Expected<std::string> try_read_file_contents(const std::filesystem::path& file_path) {
+    std::FILE* const file{std::fopen(file_path.c_str(), "rb")};
+    if (file == nullptr) return AocError::file_read(file_path, errno);
+
+    // Read straight into a string of the file's size plus one byte, so that a single read
+    // reaches the end without a stream buffer and a copy in between.
+    // Keep doubling if the file grew or its size is not known, like for pipes.
+    std::error_code size_error{};
+    const auto file_size{std::filesystem::file_size(file_path, size_error)};
+    std::string contents(size_error ? std::size_t{1} << 16 : file_size + 1, '\0');
+    std::size_t length{0};
+    while ((length += std::fread(contents.data() + length, 1, contents.size() - length, file)) ==
+           contents.size())
+        contents.resize(2 * contents.size());
+
+    const bool failed{std::ferror(file) != 0};
+    const auto error_number{errno};
+    std::fclose(file);
+    if (failed) return AocError::file_read(file_path, error_number);
+    contents.resize(length);
+    return contents;
 }
 
 /**
- * @brief Reads the content of a file and processes it using a provided parser function.
+ * @brief Reads the entire content of a file into a string.
  *
- * @tparam T The type that the file's content will be converted to.
  * @param file_path The path to the file to be read.
- * @param file_parser A function that takes the file's content and converts it to type T.
- * @return The parsed content of the file.
+ * @return The content of the file.
  * @throws FileReadException If the file could not be opened.
  */
-template <typename T>
-T read_input_file(const std::filesystem::path& file_path,
-                  const std::function<T(const std::string&)>& file_parser) {
-    const std::ifstream file{file_path};
-    if (!file.is_open()) throw FileReadException{file_path, errno};
-    std::ostringstream file_contents_stream{};
-    file_contents_stream << file.rdbuf();
-    return file_parser(file_contents_stream.str());
+inline std::string read_file_contents(const std::filesystem::path& file_path) {
+    return try_read_file_contents(file_path).value_or_throw();
 }
 
 /**
- * @brief Reads the content of a file and processes it using a provided parser function.
+ * @brief Reads the lines of a file that start within a byte range.
+ *
+ * A line belongs to the range that contains its first byte,
+ * so splitting a file into adjacent ranges and reading each of them
+ * yields every line exactly once, whatever the range boundaries are.
  *
- * @tparam T The type that the file's content will be converted to.
  * @param file_path The path to the file to be read.
- * @param file_parser A function that takes the file's content and converts it to type T.
- * @return The parsed content of the file.
- * @throws FileReadException If the file could not be opened.
+ * @param start The offset of the first byte of the range.
+ * @param end The offset one past the last byte of the range.
+ * @return The lines starting within the range, each followed by a newline.
+ * @throws FileReadException If the file could not be opened or read.
+ */
+inline std::string read_file_line_range(const std::filesystem::path& file_path,
+                                        const std::uintmax_t start, const std::uintmax_t end) {
+    std::FILE* const file{std::fopen(file_path.c_str(), "rb")};
+    if (file == nullptr) throw FileReadException{file_path, errno};
+
+    // Start one byte early and skip up to the first newline,
+    // which drops the line that started before the range unless the range starts a new line.
+    auto position{start > 0 ? start - 1 : std::uintmax_t{0}};
+    if (start > 0 && fseeko(file, static_cast<off_t>(position), SEEK_SET) != 0) {
+        std::fclose(file);
+        throw FileReadException{file_path, "Range start is past the end of the file"};
+    }
+
+    bool skipping{start > 0};
+    bool done{false};
+    std::string contents{};
+    char buffer[std::size_t{1} << 16];
+
+    while (!done) {
+        const auto count{std::fread(buffer, 1, sizeof(buffer), file)};
+        if (count == 0) break;
+        const std::string_view block{buffer, count};
+        std::size_t begin{0};
+
+        if (skipping) {
+            const auto newline{block.find('\n')};
+            if (newline == std::string_view::npos) {
+                position += count;
+                continue;
+            }
+            begin = newline + 1;
+            skipping = false;
+        }
+
+        if (position + begin < end) {
+            const auto range_end{static_cast<std::size_t>(
+                std::min<std::uintmax_t>(count, end - position))};
+            contents.append(block.substr(begin, range_end - begin));
+            begin = range_end;
+        }
+
+        if (position + begin >= end) {
+            // Finish the last line that started within the range.
+            done = true;
+            if (!contents.empty() && contents.back() != '\n') {
+                const auto newline{block.find('\n', begin)};
+                contents.append(block.substr(begin, newline == std::string_view::npos
+                                                        ? std::string_view::npos
+                                                        : newline + 1 - begin));
+                done = newline != std::string_view::npos;
+            }
+        }
+
+        position += count;
+    }
+
+    const bool failed{std::ferror(file) != 0};
+    const auto error_number{errno};
+    std::fclose(file);
+    if (failed) throw FileReadException{file_path, error_number};
+    if (!contents.empty() && contents.back() != '\n') contents += '\n';
+    return contents;
+}
+
+/**
+ * @brief A contiguous part of a text that starts at the beginning of a line.
  */
-template <typename T>
-T read_input_file(
-    const std::filesystem::path& file_path,
-    const std::function<T(const std::string&, const std::filesystem::path&)>& file_parser) {
-    const std::ifstream file{file_path};
-    if (!file.is_open()) throw FileReadException{file_path, errno};
-    std::ostringstream file_contents_stream{};
-    file_contents_stream << file.rdbuf();
-    return file_parser(file_contents_stream.str(), file_path);
+struct TextChunk {
+    /**
+     * @brief The offset of the first byte of the chunk in the whole text.
+     */
+    std::size_t byte_offset{};
+
+    /**
+     * @brief The text of the chunk, which consists of whole lines.
+     */
+    std::string_view text{};
+};
+
+/**
+ * @brief Splits a text into chunks of roughly equal size that only contain whole lines.
+ *
+ * @param text The text to split.
+ * @param max_chunk_count The maximum number of chunks to create.
+ * @param min_chunk_size The minimum size of a chunk in bytes, except for the last one.
+ * @return The chunks in order. Together they cover the whole text.
+ */
+inline std::vector<TextChunk> split_at_line_boundaries(const std::string_view text,
+                                                       const std::size_t max_chunk_count,
+                                                       const std::size_t min_chunk_size) {
+    const auto chunk_count{
+        std::max<std::size_t>(1, std::min(max_chunk_count, text.size() / std::max<std::size_t>(
+                                                                              1, min_chunk_size)))};
+    const auto target_size{text.size() / chunk_count};
+    std::vector<TextChunk> chunks{};
+    std::size_t begin{0};
+
+    while (begin < text.size()) {
+        std::size_t end{text.size()};
+
+        if (chunks.size() + 1 < chunk_count) {
+            // Extend the chunk to the end of the line containing its target end.
+            const auto newline{text.find('\n', begin + std::max<std::size_t>(1, target_size) - 1)};
+            if (newline != std::string_view::npos) end = newline + 1;
+        }
+
+        chunks.push_back({begin, text.substr(begin, end - begin)});
+        begin = end;
+    }
+
+    return chunks;
+}
+
+/**
+ * @brief Calls a function for every line in a text.
+ *
+ * Lines are split the same way as @c std::getline does:
+ * the line terminator is not included, and a final terminator does not start an empty line.
+ *
+ * @tparam F The type of the function, callable as `f(std::string_view line, std::size_t offset)`.
+ * @param text The text to split into lines.
+ * @param f The function to call with each line and the offset of its first byte in @p text.
+ * @return The number of lines.
+ */
+template <typename F>
+std::size_t for_each_line(const std::string_view text, F&& f) {
+    std::size_t line_count{0};
+    std::size_t begin{0};
+
+    while (begin < text.size()) {
+        auto end{text.find('\n', begin)};
+        if (end == std::string_view::npos) end = text.size();
+        f(text.substr(begin, end - begin), begin);
+        ++line_count;
+        begin = end + 1;
+    }
+
+    return line_count;
 }
 
 }  // namespace aoc24::utils
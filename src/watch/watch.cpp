@@ -0,0 +1,399 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "watch.h"
+
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifndef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+#endif
+
+#include <fcntl.h>
+#include <poll.h>
+#include <spdlog/spdlog.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "../AocException.h"
+#include "../Expected.h"
+#include "../day1/day1.h"
+#include "../day2/day2.h"
+#include "../signals.h"
+
+namespace aoc24::watch {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/** The number of bytes before the end of the processed data that must not change on an append. */
+constexpr std::size_t kFingerprintSize{64};
+constexpr std::size_t kReadSize{std::size_t{1} << 16};
+
+/**
+ * @brief Closes a file descriptor on destruction.
+ */
+struct FileDescriptor {
+    int fd{-1};
+
+    explicit FileDescriptor(const int descriptor) : fd{descriptor} {}
+    FileDescriptor(const FileDescriptor& other) = delete;
+    FileDescriptor(FileDescriptor&& other) = delete;
+    FileDescriptor& operator=(const FileDescriptor& other) = delete;
+    FileDescriptor& operator=(FileDescriptor&& other) = delete;
+
+    ~FileDescriptor() {
+        if (fd >= 0) close(fd);
+    }
+};
+
+/**
+ * @brief Reads a byte range of a file, or less if the file ends before the range does.
+ */
+[[nodiscard]] std::string read_range(const int fd, const std::filesystem::path& file_path,
+                                     const std::uintmax_t start, const std::uintmax_t end) {
+    std::string contents(end - start, '\0');
+    std::size_t filled{0};
+
+    while (filled < contents.size()) {
+        const auto count{std::min(kReadSize, contents.size() - filled)};
+        const auto result{
+            pread(fd, contents.data() + filled, count, static_cast<off_t>(start + filled))};
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            throw FileReadException{file_path, errno};
+        }
+        if (result == 0) break;
+        filled += static_cast<std::size_t>(result);
+    }
+
+    contents.resize(filled);
+    return contents;
+}
+
+/**
+ * @brief The part of the input that has to be processed.
+ */
+struct Change {
+    /** Whether @c text is the whole file, rather than what was appended. */
+    bool full{};
+    /** The text to process. */
+    std::string text{};
+};
+
+/**
+ * @brief Tracks how much of the input was processed and tells appends apart from rewrites.
+ *
+ * An update is only treated as an append if the file is the same inode, did not shrink,
+ * the processed data ended with a complete line, and its last bytes are unchanged.
+ * This catches truncation, replacement and edits near the end,
+ * but not an in-place edit of earlier lines that also grows the file.
+ * Appended text is only processed up to its last newline.
+ */
+class TailReader final {
+    std::filesystem::path file_path_{};
+    bool valid_{false};
+    dev_t device_{};
+    ino_t inode_{};
+    timespec modified_{};
+    std::uintmax_t processed_size_{};
+    bool ends_with_newline_{true};
+    std::string fingerprint_{};
+
+    [[nodiscard]] bool is_append(const int fd, const struct stat& status) const {
+        const auto size{static_cast<std::uintmax_t>(status.st_size)};
+        if (!valid_ || status.st_dev != device_ || status.st_ino != inode_) return false;
+        if (size < processed_size_ || !ends_with_newline_) return false;
+        const auto fingerprint_start{processed_size_ - fingerprint_.size()};
+        return read_range(fd, file_path_, fingerprint_start, processed_size_) == fingerprint_;
+    }
+
+    [[nodiscard]] bool is_unchanged(const struct stat& status) const {
+        return valid_ && status.st_dev == device_ && status.st_ino == inode_ &&
+               static_cast<std::uintmax_t>(status.st_size) == processed_size_ &&
+               status.st_mtim.tv_sec == modified_.tv_sec &&
+               status.st_mtim.tv_nsec == modified_.tv_nsec;
+    }
+
+  public:
+    explicit TailReader(std::filesystem::path file_path) : file_path_{std::move(file_path)} {}
+
+    /**
+     * @brief Makes the next call to @c read_changes reload the whole file.
+     */
+    void invalidate() { valid_ = false; }
+
+    /**
+     * @brief Reads what changed since the previous call.
+     *
+     * @return The appended or complete text, or an empty optional if nothing changed.
+     * @throws FileReadException If the file cannot be opened or read.
+     */
+    [[nodiscard]] std::optional<Change> read_changes() {
+        const FileDescriptor file{open(file_path_.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (file.fd < 0) throw FileReadException{file_path_, errno};
+
+        struct stat status {};
+        if (fstat(file.fd, &status) != 0) throw FileReadException{file_path_, errno};
+        if (is_unchanged(status)) return std::nullopt;
+
+        const auto size{static_cast<std::uintmax_t>(status.st_size)};
+        const bool full{!is_append(file.fd, status)};
+        const auto start{full ? 0 : processed_size_};
+        Change change{full, read_range(file.fd, file_path_, start, size)};
+
+        if (full) {
+            ends_with_newline_ = change.text.empty() || change.text.back() == '\n';
+        } else {
+            // A fragment of a line that is still being written may parse as a different line,
+            // so leave it for a later batch.
+            const auto last_newline{change.text.rfind('\n')};
+            if (last_newline == std::string::npos) return std::nullopt;
+            change.text.resize(last_newline + 1);
+        }
+        processed_size_ = start + change.text.size();
+        fingerprint_ = read_range(file.fd, file_path_,
+                                  processed_size_ - std::min(processed_size_, kFingerprintSize),
+                                  processed_size_);
+        device_ = status.st_dev;
+        inode_ = status.st_ino;
+        modified_ = status.st_mtim;
+        valid_ = true;
+        return change;
+    }
+};
+
+/**
+ * @brief Applies changes of a day 1 input and prints the answers.
+ */
+class LocationListsSolver final {
+    const std::filesystem::path& file_path_;
+    LocationListTotals totals_{};
+
+  public:
+    explicit LocationListsSolver(const std::filesystem::path& file_path)
+        : file_path_{file_path} {}
+
+    [[nodiscard]] std::optional<AocError> apply(const Change& change) {
+        auto lists{day1::try_parse_location_lists(change.text, file_path_)};
+        if (!lists) return lists.error();
+        if (change.full) totals_.clear();
+        totals_.add(std::move(lists->first), std::move(lists->second));
+        return std::nullopt;
+    }
+
+    void print() const {
+        fmt::print("The total distance is {}.\n", totals_.total_distance());
+        fmt::print("The similarity score is {}.\n", totals_.similarity_score());
+        std::fflush(stdout);
+    }
+};
+
+/**
+ * @brief Applies changes of a day 2 input and prints the answer.
+ */
+class ReactorDataSolver final {
+    ReportTotals totals_{};
+
+  public:
+    [[nodiscard]] std::optional<AocError> apply(const Change& change) {
+        const auto reports{day2::try_parse_reactor_data(change.text)};
+        if (!reports) return reports.error();
+        if (change.full) totals_.clear();
+        totals_.add(*reports);
+        return std::nullopt;
+    }
+
+    void print() const {
+        fmt::print("There are {} safe reports.\n", totals_.dampened_safe_count());
+        std::fflush(stdout);
+    }
+};
+
+/**
+ * @brief Counts the inotify events about the input file, draining the queue.
+ */
+[[nodiscard]] std::size_t drain_events(const int inotify_fd, const std::string_view file_name) {
+    alignas(inotify_event) char buffer[4096];
+    std::size_t relevant_events{0};
+
+    while (true) {
+        const auto length{read(inotify_fd, buffer, sizeof(buffer))};
+        if (length <= 0) break;
+
+        for (std::size_t offset{0}; offset < static_cast<std::size_t>(length);) {
+            const auto* event{reinterpret_cast<const inotify_event*>(buffer + offset)};
+            // After an overflow the lost events may have been about the input.
+            if ((event->mask & IN_Q_OVERFLOW) != 0 ||
+                (event->len > 0 && file_name == event->name))
+                ++relevant_events;
+            offset += sizeof(inotify_event) + event->len;
+        }
+    }
+
+    return relevant_events;
+}
+
+/**
+ * @brief Processes the changes of one batch and publishes the new answers.
+ */
+template <typename Solver>
+void update(Solver& solver, TailReader& reader, const Clock::time_point first_event,
+            const std::size_t event_count) {
+    std::optional<Change> change{};
+    try {
+        change = reader.read_changes();
+    } catch (const FileReadException& error) {
+        // The file may be in the middle of being replaced; the replacement triggers a new batch.
+        SPDLOG_WARN(error.error_message());
+        reader.invalidate();
+        return;
+    }
+
+    if (!change) {
+        SPDLOG_DEBUG("Ignoring {} events that did not change the input.", event_count);
+        return;
+    }
+
+    if (const auto error{solver.apply(*change)}) {
+        SPDLOG_ERROR("Skipping an update of the input: {}", error->message());
+        // Whatever is appended next, the unparsable part has to be read again.
+        reader.invalidate();
+        return;
+    }
+
+    solver.print();
+    const std::chrono::duration<double, std::milli> latency{Clock::now() - first_event};
+    SPDLOG_INFO("Published answers from {} ({} bytes) {:.2f} ms after the first of {} events.",
+                change->full ? "the whole file" : "the appended lines", change->text.size(),
+                latency.count(), event_count);
+}
+
+template <typename Solver>
+void run(Solver solver, const std::filesystem::path& file_path, const WatchConfig& config) {
+    const FileDescriptor inotify{inotify_init1(IN_NONBLOCK | IN_CLOEXEC)};
+    const auto directory{file_path.has_parent_path() ? file_path.parent_path()
+                                                     : std::filesystem::path{"."}};
+    if (inotify.fd < 0 ||
+        inotify_add_watch(inotify.fd, directory.c_str(),
+                          IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                              IN_MOVED_TO | IN_ATTRIB) < 0)
+        throw FileReadException{directory, errno};
+    const auto file_name{file_path.filename().string()};
+
+    TailReader reader{file_path};
+    if (const auto error{solver.apply(*reader.read_changes())}) error->raise();
+    solver.print();
+
+    signals::install_stop_handlers();
+    SPDLOG_INFO("Watching {} for changes.", file_path.string());
+
+    // A batch is pending while event_count is positive.
+    Clock::time_point first_event{};
+    Clock::time_point last_event{};
+    std::size_t event_count{0};
+
+    const auto deadline{[&] {
+        return std::min(last_event + config.debounce, first_event + config.max_latency);
+    }};
+
+    while (!signals::stop_requested()) {
+        int timeout{-1};
+        if (event_count > 0) {
+            const auto remaining{
+                std::chrono::ceil<std::chrono::milliseconds>(deadline() - Clock::now())};
+            timeout = static_cast<int>(std::max<std::int64_t>(0, remaining.count()));
+        }
+
+        pollfd poll_fd{inotify.fd, POLLIN, 0};
+        if (poll(&poll_fd, 1, timeout) < 0 && errno != EINTR)
+            throw FileReadException{directory, errno};
+
+        if ((poll_fd.revents & POLLIN) != 0) {
+            if (const auto relevant_events{drain_events(inotify.fd, file_name)}) {
+                last_event = Clock::now();
+                if (event_count == 0) first_event = last_event;
+                event_count += relevant_events;
+            }
+        }
+
+        if (event_count > 0 && Clock::now() >= deadline()) {
+            update(solver, reader, first_event, event_count);
+            event_count = 0;
+        }
+    }
+}
+
+}  // namespace
+
+void LocationListTotals::clear() { *this = LocationListTotals{}; }
+
+void LocationListTotals::add(std::vector<int> left_list, std::vector<int> right_list) {
+    // Each new left ID matches the right IDs seen so far, and each new right ID all left IDs.
+    for (const int id : left_list) {
+        auto& counts{counts_[id]};
+        ++counts.left;
+        similarity_score_ += std::int64_t{id} * counts.right;
+    }
+    for (const int id : right_list) {
+        auto& counts{counts_[id]};
+        ++counts.right;
+        similarity_score_ += std::int64_t{id} * counts.left;
+    }
+
+    const auto merge{[](std::vector<int>& sorted, std::vector<int>& added) {
+        std::sort(added.begin(), added.end());
+        const auto middle{static_cast<std::ptrdiff_t>(sorted.size())};
+        sorted.insert(sorted.end(), added.begin(), added.end());
+        std::inplace_merge(sorted.begin(), sorted.begin() + middle, sorted.end());
+    }};
+    merge(left_list_, left_list);
+    merge(right_list_, right_list);
+
+    total_distance_ = day1::sum_of_distances(left_list_, right_list_);
+}
+
+void ReportTotals::add(const std::vector<day2::Report>& reports) {
+    for (const auto& report : reports) {
+        const auto removal{
+            day2::evaluate_problem_dampener(report, day2::report_is_safe_until(report))};
+        if (removal == day2::DampenerRemoval::not_needed) ++safe_count_;
+        if (removal != day2::DampenerRemoval::failed) ++dampened_safe_count_;
+    }
+    report_count_ += reports.size();
+}
+
+void watch_input(const int day, const std::filesystem::path& file_path,
+                 const WatchConfig& config) {
+    if (day == 1)
+        run(LocationListsSolver{file_path}, file_path, config);
+    else
+        run(ReactorDataSolver{}, file_path, config);
+}
+
+}  // namespace aoc24::watch
@@ -0,0 +1,132 @@
+// This file is part of my solutions for Advent of Code 2024.
+// Copyright (C) 2024  Luka Berkers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef AOC24_CPP_SRC_WATCH_WATCH_H_
+#define AOC24_CPP_SRC_WATCH_WATCH_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+
+#include "../day2/Report.h"
+
+namespace aoc24::watch {
+
+/**
+ * @brief The settings of watch mode.
+ */
+struct WatchConfig {
+    /** How long the input must stay unchanged before a burst of writes is processed. */
+    std::chrono::milliseconds debounce{20};
+    /** The longest time a write waits to be processed, however long the burst lasts. */
+    std::chrono::milliseconds max_latency{200};
+};
+
+/**
+ * @brief The day 1 answers, maintained while location ID pairs are appended.
+ */
+class LocationListTotals final {
+    struct Counts {
+        std::int64_t left{};
+        std::int64_t right{};
+    };
+
+    std::vector<int> left_list_{};
+    std::vector<int> right_list_{};
+    std::unordered_map<int, Counts> counts_{};
+    std::int64_t total_distance_{};
+    std::int64_t similarity_score_{};
+
+  public:
+    /**
+     * @brief Forgets all pairs.
+     */
+    void clear();
+
+    /**
+     * @brief Adds location ID pairs.
+     *
+     * The similarity score is updated from the new IDs alone.
+     * The new IDs are merged into the sorted lists, after which the distances are summed again.
+     *
+     * @param left_list The new left IDs.
+     * @param right_list The new right IDs, as many as there are left IDs.
+     */
+    void add(std::vector<int> left_list, std::vector<int> right_list);
+
+    /** The number of pairs. */
+    [[nodiscard]] std::size_t pair_count() const { return left_list_.size(); }
+    /** The sum of the distances between the paired location IDs. */
+    [[nodiscard]] std::int64_t total_distance() const { return total_distance_; }
+    /** The similarity score of the two location lists. */
+    [[nodiscard]] std::int64_t similarity_score() const { return similarity_score_; }
+};
+
+/**
+ * @brief The day 2 answers, maintained while reports are appended.
+ */
+class ReportTotals final {
+    std::size_t report_count_{};
+    std::size_t safe_count_{};
+    std::size_t dampened_safe_count_{};
+
+  public:
+    /**
+     * @brief Forgets all reports.
+     */
+    void clear() { *this = ReportTotals{}; }
+
+    /**
+     * @brief Evaluates and counts new reports.
+     *
+     * @param reports The new reports.
+     * @throw OverflowException If a report is too long to evaluate.
+     */
+    void add(const std::vector<day2::Report>& reports);
+
+    /** The number of reports. */
+    [[nodiscard]] std::size_t report_count() const { return report_count_; }
+    /** The number of reports that are safe on their own. */
+    [[nodiscard]] std::size_t safe_count() const { return safe_count_; }
+    /** The number of reports that are safe when using the problem dampener. */
+    [[nodiscard]] std::size_t dampened_safe_count() const { return dampened_safe_count_; }
+};
+
+/**
+ * @brief Solves a day and re-solves it whenever the input file changes,
+ *        until interrupted by @c SIGINT or @c SIGTERM.
+ *
+ * The directory of the input is watched with inotify, which also notices editors that replace
+ * the file. When the file only grew, just the appended lines are parsed and added to the totals.
+ * Otherwise, for instance when it was truncated, replaced or edited in place, it is reloaded
+ * completely. Each burst of writes is batched into one update that is published once the file
+ * has been quiet for @c WatchConfig::debounce, or at the latest @c WatchConfig::max_latency after
+ * the first write. Updates that fail to parse are logged and skipped.
+ *
+ * @param day The day to solve, 1 or 2.
+ * @param file_path The input file.
+ * @param config The batching settings.
+ * @throws FileReadException If the input cannot be read or watched on startup.
+ * @throws ParseException If the input cannot be parsed on startup.
+ */
+void watch_input(int day, const std::filesystem::path& file_path, const WatchConfig& config);
+
+}  // namespace aoc24::watch
+
+#endif  // AOC24_CPP_SRC_WATCH_WATCH_H_